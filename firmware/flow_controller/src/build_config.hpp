@@ -0,0 +1,57 @@
+#pragma once
+/*  build_config.hpp – compile-time subsystem selection
+ *  ---------------------------------------------------
+ *  A configuration is a type: one policy per hardware role plus
+ *  constexpr feature switches.  The control loop is a template on it
+ *  (MinCtrl<Cfg>), so an unused display / input / feature costs
+ *  nothing – its calls are never instantiated, and if constexpr
+ *  drops the disabled features.
+ *
+ *  Role interfaces (checked when MinCtrl<Cfg> is instantiated):
+ *      Display : begin(), advancePage(), show(const volatile SystemState&)
+ *      Input   : begin(), poll(), pageChanged()
+ *      Sensor  : a Hal::FlowSensor<> back-end  (devices/hal/hal.hpp)
+ *      Pump    : a Hal::Pump<> back-end
+ *
+ *  To change the board, edit `Active`; the firmware instantiates only
+ *  that one.  `Simulated` and `Replay` are built and timed on the host
+ *  by tools/sim/sim_configs.cpp; the rest are checked when selected.
+ */
+
+#include "devices/_devices.hpp"
+
+namespace Build {
+
+template <class DisplayT, class InputT, class SensorT, class PumpT,
+          bool SerialCmdT, bool TelemetryT>
+struct Config {
+    using Display = DisplayT;
+    using Input   = InputT;
+    using Sensor  = SensorT;
+    using Pump    = PumpT;
+
+    static constexpr bool SERIAL_CMD = SerialCmdT;  // SerialCmd::poll each tick
+    static constexpr bool TELEMETRY  = TelemetryT;  // SerialRpt::tick each tick
+};
+
+/* ─── the board as shipped ─── */
+using Active       = Config<Sh1107Display, ButtonsTwo, Slf3sSensor, Drv8825Pump,
+                            true, true>;
+
+/* ─── control path only: no UI, no serial I/O ─── */
+using Headless     = Config<NullDisplay, NullInput, Slf3sSensor, Drv8825Pump,
+                            false, false>;
+
+/* ─── older SSD1306 front panel ─── */
+using Ssd1306Board = Config<Ssd1306Display, ButtonsTwo, Slf3sSensor, Drv8825Pump,
+                            true, true>;
+
+/* ─── bare board: plant model instead of sensor + pump ─── */
+using Simulated    = Config<NullDisplay, NullInput, SimSensor, SimPump,
+                            true, true>;
+
+/* ─── recorded trace in, simulated odometer out ─── */
+using Replay       = Config<NullDisplay, NullInput, ReplaySensor, SimPump,
+                            true, true>;
+
+}   // namespace Build
@@ -5,7 +5,22 @@
 // Includes filtering, gain scheduling, and PID
 // ─────────────────────────────────────────
 
+#include "sample/sample.hpp"
 #include "filter/filter.hpp"
+#include "filter/biquad.hpp"
+#include "filter/notch.hpp"
 #include "gain/gain.hpp"
 #include "pid/pid.hpp"
+#include "pid/flow_pid.hpp"
 #include "volume_tracker/volume_tracker.hpp"
+#include "bubble_guard/bubble_guard.hpp"
+#include "sp_program/sp_program.hpp"
+#include "dose/dose.hpp"
+#include "tick_stats/tick_stats.hpp"
+#include "occlusion/occlusion.hpp"
+#include "totalizer/totalizer.hpp"
+#include "temp_comp/temp_comp.hpp"
+#include "cal_curve/cal_curve.hpp"
+#include "grav_cal/grav_cal.hpp"
+#include "ripple/ripple.hpp"
+#include "flow_kf/flow_kf.hpp"
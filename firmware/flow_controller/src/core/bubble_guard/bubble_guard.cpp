@@ -0,0 +1,24 @@
+#include "bubble_guard.hpp"
+
+bool BubbleGuard::update(bool flagged, uint32_t now_ms)
+{
+    if (flagged) {
+        if (!_active) {                         // rising edge → new event
+            _active  = true;
+            _startMs = now_ms;
+            ++_events;
+        }
+        _lastFlagMs = now_ms;
+    } else if (_active && now_ms - _lastFlagMs >= _releaseMs) {
+        _active   = false;                      // falling edge after hold-off
+        _endMs    = now_ms;
+        _totalMs += now_ms - _startMs;
+    }
+    return _active;
+}
+
+void BubbleGuard::reset()
+{
+    _active = false;
+    _events = _startMs = _endMs = _totalMs = 0;
+}
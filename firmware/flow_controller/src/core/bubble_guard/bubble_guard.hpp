@@ -0,0 +1,34 @@
+#pragma once
+/*  bubble_guard.hpp ─ air-in-line latch for the SLF3S flag word
+ *  ------------------------------------------------------------
+ *  • update()  — feed the sensor's air-in-line bit once per tick
+ *  • active()  — true while flagged + BUBBLE_RELEASE_MS afterwards
+ *  • getters   — event count, last start / end stamps, total time
+ *
+ *  The release delay keeps the guard latched through the flow
+ *  spike that trails the flag by a few samples.
+ */
+
+#include <stdint.h>
+
+class BubbleGuard {
+public:
+    explicit BubbleGuard(uint32_t release_ms = 0) : _releaseMs(release_ms) {}
+
+    bool update(bool flagged, uint32_t now_ms);   // returns active()
+    void reset();
+
+    bool     active()   const { return _active; }
+    uint32_t events()   const { return _events; }
+    uint32_t lastStartMs() const { return _startMs; }
+    uint32_t lastEndMs()   const { return _endMs; }
+    uint32_t totalMs()  const { return _totalMs; }
+
+private:
+    uint32_t _releaseMs;
+    bool     _active{false};
+    uint32_t _lastFlagMs{0};
+    uint32_t _events{0};
+    uint32_t _startMs{0}, _endMs{0};
+    uint32_t _totalMs{0};
+};
@@ -0,0 +1,175 @@
+/*  cal_curve.cpp – pair table, monotone fit, grid lookup, persistence
+ *  ------------------------------------------------------------------
+ */
+
+#include "cal_curve.hpp"
+#include "../../include/_include.hpp"          // CAL_*, EE_ADDR_CAL
+#include <EEPROM.h>
+#include <math.h>
+#include <string.h>
+
+namespace CalCurve {
+
+/* ───────── EEPROM layout ───────── */
+static constexpr uint32_t MAGIC   = 0x43414C31;   // "CAL1"
+static constexpr uint8_t  VERSION = 1;
+
+struct CalBlob {
+    uint32_t magic;
+    uint8_t  ver;
+    uint8_t  n;
+    Pair     pts[CAL_MAX_PAIRS];
+};
+static_assert(EE_ADDR_CAL + sizeof(CalBlob) <= EE_SIZE,
+              "calibration table overruns EEPROM area");
+
+/* ───────── module state ───────── */
+static Pair    gPts[CAL_MAX_PAIRS];              // sorted by ind
+static uint8_t gN = 0;
+static float   gGain[CAL_GRID_POINTS];
+static bool    gInit = false;
+
+static constexpr float INV_STEP = 1.0f / CAL_GRID_STEP_UL;
+
+static inline void ensure() { if (!gInit) clear(); }
+
+static inline bool plausible(float ind, float ref)
+{
+    return ind > 0.0f && ref > 0.0f &&
+           ref >= CAL_GAIN_MIN * ind && ref <= CAL_GAIN_MAX * ind;
+}
+
+/* Fritsch–Butland: weighted harmonic mean of the neighbouring
+   secants, 0 at a local extremum – never overshoots the data   */
+static float tangent(uint8_t k)
+{
+    if (k == 0)      return (gPts[1].ref - gPts[0].ref) / (gPts[1].ind - gPts[0].ind);
+    if (k == gN - 1) return (gPts[k].ref - gPts[k-1].ref) / (gPts[k].ind - gPts[k-1].ind);
+
+    float h0 = gPts[k].ind   - gPts[k-1].ind, d0 = (gPts[k].ref   - gPts[k-1].ref) / h0;
+    float h1 = gPts[k+1].ind - gPts[k].ind,   d1 = (gPts[k+1].ref - gPts[k].ref)   / h1;
+    if (d0 * d1 <= 0.0f) return 0.0f;
+    return 3.0f * (h0 + h1) / ((2.0f * h1 + h0) / d0 + (h1 + 2.0f * h0) / d1);
+}
+
+/* ───────── public ───────── */
+float gainAt(float raw)
+{
+    ensure();
+    float x = fabsf(raw) * INV_STEP;
+    if (!(x < CAL_GRID_POINTS - 1)) return gGain[CAL_GRID_POINTS - 1];   // also NaN
+    uint8_t i = static_cast<uint8_t>(x);
+    float   f = x - i;
+    return gGain[i] + (gGain[i + 1] - gGain[i]) * f;
+}
+
+float correct(float raw) { return raw * gainAt(raw); }
+
+bool fit()
+{
+    ensure();
+    if (gN == 0) {
+        for (float& g : gGain) g = 1.0f;
+        return true;
+    }
+    for (uint8_t k = 1; k < gN; ++k)
+        if (!(gPts[k].ref > gPts[k-1].ref)) return false;   // true flow must rise
+
+    float m[CAL_MAX_PAIRS];
+    for (uint8_t k = 0; k < gN; ++k) m[k] = gN > 1 ? tangent(k) : 0.0f;
+
+    const float kLo = gPts[0].ref / gPts[0].ind;
+    const float kHi = gPts[gN-1].ref / gPts[gN-1].ind;
+    uint8_t     k   = 0;                                    // segment cursor
+
+    for (uint8_t i = 0; i < CAL_GRID_POINTS; ++i) {
+        float x = i * CAL_GRID_STEP_UL;
+        if (x <= gPts[0].ind)      { gGain[i] = kLo; continue; }
+        if (x >= gPts[gN-1].ind)   { gGain[i] = kHi; continue; }
+        while (x > gPts[k + 1].ind) ++k;
+
+        /* cubic Hermite on [k, k+1] */
+        float h  = gPts[k+1].ind - gPts[k].ind;
+        float t  = (x - gPts[k].ind) / h, t2 = t * t, t3 = t2 * t;
+        float y  = ( 2*t3 - 3*t2 + 1) * gPts[k].ref   + (t3 - 2*t2 + t) * h * m[k]
+                 + (-2*t3 + 3*t2)     * gPts[k+1].ref + (t3 - t2)       * h * m[k+1];
+        gGain[i] = y / x;
+    }
+    return true;
+}
+
+bool add(float ind, float ref)
+{
+    ensure();
+    if (!plausible(ind, ref)) return false;
+
+    Pair    keep[CAL_MAX_PAIRS];
+    uint8_t keepN = gN;
+    memcpy(keep, gPts, sizeof(gPts));
+
+    /* replace a near neighbour, else insert in order */
+    uint8_t k = 0;
+    while (k < gN && gPts[k].ind < ind - CAL_MERGE_UL) ++k;
+    if (k < gN && fabsf(gPts[k].ind - ind) < CAL_MERGE_UL) {
+        gPts[k] = {ind, ref};
+    } else {
+        if (gN >= CAL_MAX_PAIRS) return false;
+        memmove(&gPts[k + 1], &gPts[k], (gN - k) * sizeof(Pair));
+        gPts[k] = {ind, ref};
+        ++gN;
+    }
+
+    if (fit()) return true;
+    memcpy(gPts, keep, sizeof(gPts)); gN = keepN;            // roll back
+    fit();
+    return false;
+}
+
+bool remove(uint8_t i)
+{
+    ensure();
+    if (i >= gN) return false;
+    memmove(&gPts[i], &gPts[i + 1], (gN - i - 1) * sizeof(Pair));
+    --gN;
+    return fit();                   // a subset of a monotone set stays monotone
+}
+
+void clear()
+{
+    gN    = 0;
+    gInit = true;
+    fit();
+}
+
+bool load()
+{
+    clear();
+    CalBlob blob{}; EEPROM.get(EE_ADDR_CAL, blob);
+    if (blob.magic != MAGIC || blob.ver != VERSION ||
+        blob.n > CAL_MAX_PAIRS) return false;
+
+    for (uint8_t k = 0; k < blob.n; ++k) {
+        if (!plausible(blob.pts[k].ind, blob.pts[k].ref)) { clear(); return false; }
+        gPts[k] = blob.pts[k];
+    }
+    gN = blob.n;
+    if (!fit()) { clear(); return false; }
+    return true;
+}
+
+void save()
+{
+    ensure();
+    CalBlob blob{};
+    blob.magic = MAGIC; blob.ver = VERSION; blob.n = gN;
+    memcpy(blob.pts, gPts, sizeof(gPts));
+    EEPROM.put(EE_ADDR_CAL, blob);
+    State::requestCommit();                    // written between ticks
+}
+
+uint8_t     count()            { return gN; }
+const Pair& pair(uint8_t i)    { return gPts[i < CAL_MAX_PAIRS ? i : 0]; }
+float       gridUL(uint8_t i)  { return i * CAL_GRID_STEP_UL; }
+float       gridGain(uint8_t i){ ensure(); return gGain[i < CAL_GRID_POINTS ? i : 0]; }
+
+}   // namespace CalCurve
@@ -0,0 +1,44 @@
+#pragma once
+/*  cal_curve.hpp – multi-point flow-sensor calibration
+ *  ---------------------------------------------------
+ *  Replaces the single ±% factor with a curve fitted through up to
+ *  CAL_MAX_PAIRS reference points (indicated, true) in µL/min.
+ *
+ *  fit()     – monotone cubic (Fritsch–Butland tangents) through the
+ *              sorted pairs, sampled once onto a uniform grid of
+ *              gains k = true / indicated.  Runs on every edit, off
+ *              the sample path; storage is fixed, nothing allocates.
+ *  correct() – |raw| → grid index by one multiply, then a lerp of
+ *              the two bracketing gains: O(1) per sample.
+ *
+ *  Pairs are in *uncorrected* sensor units (the curve never feeds
+ *  itself): MinCtrl applies correct() to every back-end's sample
+ *  ahead of the temperature gain, and hands the uncorrected value
+ *  to GravCal.  Below the first / above the last pair the end gain
+ *  holds.  No pairs → gain 1, one pair → a flat gain.
+ */
+
+#include <stdint.h>
+
+namespace CalCurve {
+
+struct Pair { float ind, ref; };      // indicated / true, µL/min
+
+float correct(float raw_uLmin);       // raw · k(|raw|)
+float gainAt(float raw_uLmin);
+
+bool  add(float ind, float ref);      // insert / replace, refit
+bool  remove(uint8_t i);              // by sorted index, refit
+void  clear();                        // no pairs, gain 1
+bool  fit();                          // false: pairs not monotone
+
+bool  load();                         // EEPROM (EE_ADDR_CAL)
+void  save();                         // stage; committed between ticks
+
+/* table access for reporting */
+uint8_t     count();
+const Pair& pair(uint8_t i);
+float       gridUL(uint8_t i);
+float       gridGain(uint8_t i);
+
+}   // namespace CalCurve
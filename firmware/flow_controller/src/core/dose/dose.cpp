@@ -0,0 +1,112 @@
+/*  dose.cpp – exact-volume dose sequencer & accuracy statistics
+ */
+
+#include "dose.hpp"
+#include "../../include/_include.hpp"          // UL_PER_STEP, DOSE_*
+#include <math.h>
+
+namespace Dose {
+
+/* ───────── module state ───────── */
+static Phase    gPhase    = Phase::IDLE;
+static float    gPending  = 0.0f;       // > 0 ⇒ start on next tick
+static bool     gAbort    = false;
+
+static float    gTarget   = 0.0f;
+static uint32_t gOdo0     = 0;
+static uint32_t gSteps    = 0;
+static float    gVol0     = 0.0f;
+static uint32_t gT0       = 0;
+static uint32_t gTStop    = 0;
+
+static Stats    gStats;
+
+/* ───────── requests ───────── */
+bool request(float target_uL)
+{
+    if (active() || target_uL < UL_PER_STEP) return false;
+    gPending = target_uL;
+    return true;
+}
+
+void abort() { if (active() || gPending > 0.0f) gAbort = true; }
+
+/* ───────── bookkeeping for a finished run ───────── */
+static void score(float vol_uL)
+{
+    Stats& s  = gStats;
+    s.target_uL = gTarget;
+    s.step_uL   = gSteps * UL_PER_STEP;
+    s.meas_uL   = vol_uL - gVol0;
+    s.err_pct   = 100.0f * (s.meas_uL - gTarget) / gTarget;
+    s.run_ms    = gTStop - gT0;
+
+    /* running means; worst keeps its sign */
+    float e = s.err_pct;
+    ++s.runs;
+    s.meanErr_pct    += (e        - s.meanErr_pct)    / s.runs;
+    s.meanAbsErr_pct += (fabsf(e) - s.meanAbsErr_pct) / s.runs;
+    if (fabsf(e) > fabsf(s.worstErr_pct)) s.worstErr_pct = e;
+}
+
+/* ───────── per-tick sequencer ───────── */
+Event tick(uint32_t odo, float vol_uL, bool stopped, bool running, uint32_t now_ms)
+{
+    if (gAbort) {
+        gAbort = false; gPending = 0.0f;
+        gPhase = Phase::IDLE;
+        return Event::ABORTED;
+    }
+
+    switch (gPhase) {
+        case Phase::IDLE:
+        case Phase::DONE:
+            if (gPending <= 0.0f) return Event::NONE;
+            gTarget  = gPending; gPending = 0.0f;
+            gSteps   = static_cast<uint32_t>(gTarget / UL_PER_STEP + 0.5f);
+            gOdo0    = odo;
+            gVol0    = vol_uL;
+            gT0      = now_ms;
+            gPhase   = Phase::RUNNING;
+            return Event::STARTED;
+
+        case Phase::RUNNING:
+            if (!stopped && !running) {             // switched off mid-dose
+                gPhase = Phase::IDLE;
+                return Event::ABORTED;
+            }
+            if (!stopped) return Event::NONE;
+            gTStop = now_ms;
+            gPhase = Phase::SETTLING;
+            return Event::STOPPED;
+
+        case Phase::SETTLING:
+            if (now_ms - gTStop < DOSE_SETTLE_MS) return Event::NONE;
+            score(vol_uL);
+            gPhase = Phase::DONE;
+            return Event::FINISHED;
+    }
+    return Event::NONE;
+}
+
+/* ───────── queries ───────── */
+uint32_t stopCount() { return gOdo0 + gSteps; }
+
+float remaining_uL(uint32_t odo)
+{
+    if (gPhase != Phase::RUNNING) return 0.0f;
+    uint32_t done = odo - gOdo0;
+    return done >= gSteps ? 0.0f : (gSteps - done) * UL_PER_STEP;
+}
+
+float rateCap(uint32_t odo)
+{
+    float cap = remaining_uL(odo) * 60.0f / DOSE_BRAKE_S;   // µL/min
+    return cap < DOSE_MIN_RATE_UL_MIN ? DOSE_MIN_RATE_UL_MIN : cap;
+}
+
+Phase        phase()  { return gPhase; }
+bool         active() { return gPhase == Phase::RUNNING || gPhase == Phase::SETTLING; }
+const Stats& stats()  { return gStats; }
+
+}   // namespace Dose
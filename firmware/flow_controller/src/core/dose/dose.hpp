@@ -0,0 +1,52 @@
+#pragma once
+/*  dose.hpp ─ exact-volume dosing with predictive end-point braking
+ *  ----------------------------------------------------------------
+ *  A dose is counted in pump steps (odometer), not in sensor volume:
+ *    stop count = odo₀ + round(target / UL_PER_STEP)
+ *  The caller arms the driver's hard stop at that count, so the run
+ *  ends on the exact step.  rateCap() shapes the approach so flow
+ *  decays as  Q ≤ V_remaining / DOSE_BRAKE_S  and the tube is near
+ *  rest when the stop hits.  After the stop, the sensor volume is
+ *  integrated for DOSE_SETTLE_MS more to score the run.
+ *  Switching the pump off while RUNNING (button, "P", a fault)
+ *  aborts the dose, so a dose never outlives its pump run.
+ */
+
+#include <stdint.h>
+
+namespace Dose {
+
+enum class Phase : uint8_t { IDLE = 0, RUNNING, SETTLING, DONE };
+enum class Event : uint8_t { NONE = 0, STARTED, STOPPED, FINISHED, ABORTED };
+
+struct Stats {
+    /* last run */
+    float    target_uL{0};
+    float    step_uL{0};         // odometer volume actually commanded
+    float    meas_uL{0};         // sensor volume incl. settle tail
+    float    err_pct{0};         // (meas − target) / target
+    uint32_t run_ms{0};
+
+    /* all runs since boot */
+    uint16_t runs{0};
+    float    meanErr_pct{0};
+    float    meanAbsErr_pct{0};
+    float    worstErr_pct{0};
+};
+
+/* requests (serial / program); picked up on the next tick() */
+bool  request(float target_uL);
+void  abort();
+
+/* call once per control tick; running = pump enable flag */
+Event tick(uint32_t odo, float vol_uL, bool stopped, bool running, uint32_t now_ms);
+
+uint32_t stopCount();               // odometer value to arm
+float    rateCap(uint32_t odo);     // µL/min ceiling while RUNNING
+float    remaining_uL(uint32_t odo);
+
+Phase        phase();
+bool         active();              // RUNNING or SETTLING
+const Stats& stats();
+
+}   // namespace Dose
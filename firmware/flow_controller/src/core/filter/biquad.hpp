@@ -0,0 +1,26 @@
+#pragma once
+#include <math.h>
+
+/*──────── Direct-form-II bi-quad section ────────*/
+class BiQuad {
+public:
+    BiQuad(float b0,float b1,float b2,float a1,float a2):
+        b0_(b0),b1_(b1),b2_(b2),a1_(a1),a2_(a2) {}
+
+    /* bilinear low-pass, corner prewarped; Q = 0.5412 / 1.3066 for
+       the two sections of a 4th-order Butterworth                 */
+    static BiQuad lowpass(float fc, float fs, float q){
+        float k = tanf(float(M_PI) * fc / fs), k2 = k * k;
+        float n = 1.0f / (1.0f + k / q + k2);
+        return BiQuad(k2 * n, 2 * k2 * n, k2 * n,
+                      2 * (k2 - 1) * n, (1 - k / q + k2) * n);
+    }
+
+    float operator()(float x){
+        float v = x - a1_*z1_ - a2_*z2_;
+        float y = b0_*v + b1_*z1_ + b2_*z2_;
+        z2_ = z1_; z1_ = v; return y;
+    }
+private:
+    float b0_, b1_, b2_, a1_, a2_, z1_ = 0, z2_ = 0;
+};
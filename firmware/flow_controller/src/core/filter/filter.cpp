@@ -15,7 +15,6 @@
  #include <Arduino.h>
  #include <math.h>
  
-#ifdef ENABLE_FILTER
 
  /*──────────────────────── INTERNALS FOR ADAPTIVE α ───────────────────────*/
  static float s_b2 = 0.0f;   // solved once (slope-matching)
@@ -96,5 +95,4 @@
      float stage1 = updateDynamicLPFilter(f.dyn, in);
      return       updateEMA           (f.ema, stage1);
  }
- 
- #endif
\ No newline at end of file
+ 
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <math.h>
+#include <stdint.h>
+
+/*──────── Retunable notch section ────────
+ *  H(z) = g·(1 − 2c·z⁻¹ + z⁻²) / (1 − 2rc·z⁻¹ + r²·z⁻²),  c = cos ω
+ *  Zeros on the unit circle at ω, poles at radius r just inside;
+ *  g puts the DC gain at 1.  Direct form I: the state is past inputs
+ *  and outputs, so retuning every sample leaves no stored energy to
+ *  rescale.  tune() takes cos ω so a harmonic bank can derive
+ *  cos kω by recursion instead of calling cos() per section.       */
+class Notch {
+public:
+    /* c = cos ω, r = pole radius (< 1); r ≤ 0 bypasses */
+    void tune(float c, float r){
+        if (!(r > 0.0f)) { on_ = false; return; }
+        c_  = c; r_ = r;
+        g_  = (1.0f - 2.0f * r * c + r * r) / (2.0f - 2.0f * c);
+        on_ = true;
+    }
+
+    float operator()(float x){
+        if (!on_) { x2_ = x1_ = y2_ = y1_ = x; return x; }
+        float y = g_ * (x - 2.0f * c_ * x1_ + x2_)
+                + 2.0f * r_ * c_ * y1_ - r_ * r_ * y2_;
+        x2_ = x1_; x1_ = x; y2_ = y1_; y1_ = y;
+        return y;
+    }
+private:
+    float c_ = 1, r_ = 0, g_ = 1;
+    float x1_ = 0, x2_ = 0, y1_ = 0, y2_ = 0;
+    bool  on_ = false;
+};
+
+/* bank[k] on (k+1)·f Hz at fs, k < n, each of width centre/q; a
+   harmonic outside [fMin, fMax] bypasses.  cos kω comes from the
+   Chebyshev recursion, so the whole bank costs one cosf().       */
+inline void tuneHarmonics(Notch* bank, uint8_t n, float f, float fs,
+                          float q, float fMin, float fMax)
+{
+    const float W = 2.0f * float(M_PI) / fs;        // rad / sample per Hz
+    float c1 = cosf(W * f), cPrev = 1.0f, c = c1;
+    for (uint8_t k = 0; k < n; ++k) {
+        float fk = f * (k + 1);
+        bool  on = fk >= fMin && fk <= fMax;
+        bank[k].tune(c, on ? 1.0f - 0.5f * W * fk / q : 0.0f);
+        float cNext = 2.0f * c1 * c - cPrev;
+        cPrev = c; c = cNext;
+    }
+}
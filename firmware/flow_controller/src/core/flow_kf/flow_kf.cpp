@@ -0,0 +1,51 @@
+#include "flow_kf.hpp"
+#include <math.h>
+
+void FlowKalman::reset()
+{
+    _q = 0.0f;  _k = 1.0f;
+    _p11 = KF_P0_FLOW * KF_P0_FLOW;
+    _p12 = 0.0f;
+    _p22 = KF_P0_GAIN * KF_P0_GAIN;
+    _innov = 0.0f;
+}
+
+void FlowKalman::predict(float u, uint32_t dt_us)
+{
+    float dt = dt_us * 1e-6f;
+    float a  = expf(-dt / KF_TAU_S);
+    float b  = (1.0f - a) * u;                      // ∂q⁺/∂k
+
+    _q = a * _q + b * _k;
+
+    /* P ← F·P·Fᵀ + Q,  F = [a b; 0 1] */
+    float p11 = a * a * _p11 + 2.0f * a * b * _p12 + b * b * _p22;
+    float p12 = a * _p12 + b * _p22;
+    _p11 = p11 + KF_Q_FLOW * dt;
+    _p12 = p12;
+    /* k is only observable while the pump turns; don't let it drift
+       out of bounds across a long stop                              */
+    if (_p22 < KF_P0_GAIN * KF_P0_GAIN) _p22 += KF_Q_GAIN * dt;
+}
+
+void FlowKalman::update(float u, float z, uint32_t dt_us)
+{
+    predict(u, dt_us);
+
+    /* H = [1 0] */
+    float s   = _p11 + KF_R_FLOW;
+    float k1  = _p11 / s;
+    float k2  = _p12 / s;
+    _innov    = z - _q;
+    _q       += k1 * _innov;
+    _k       += k2 * _innov;
+    if (_k < KF_GAIN_MIN) _k = KF_GAIN_MIN;
+    if (_k > KF_GAIN_MAX) _k = KF_GAIN_MAX;
+
+    /* P ← (I − K·H)·P */
+    float p11 = (1.0f - k1) * _p11;
+    float p12 = (1.0f - k1) * _p12;
+    _p22 -= k2 * _p12;
+    _p11  = p11;
+    _p12  = p12;
+}
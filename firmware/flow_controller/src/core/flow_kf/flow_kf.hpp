@@ -0,0 +1,45 @@
+#pragma once
+/*  flow_kf.hpp ─ step-rate / sensor flow fusion (2-state EKF)
+ *  ----------------------------------------------------------
+ *  State  x = [ q  – flow at the sensor, µL/min
+ *               k  – delivered / expected volume per step ]
+ *
+ *  Process (per tick, a = e^(−dt/KF_TAU_S)):
+ *    q ← a·q + (1 − a)·k·u      u = step rate · UL_PER_STEP · kR, µL/min
+ *    k ← k                      random walk, KF_Q_GAIN
+ *  The tube between rollers and sensor is a first-order compliance:
+ *  a rate step reaches the sensor with time constant KF_TAU_S.
+ *  Measurement: z = q + v, the calibrated, notched sensor flow.
+ *  kR is TempComp's rate gain, so k is the residual and stays near 1
+ *  across temperature.
+ *
+ *  • update()   — predict + correct, for a good sample
+ *  • predict()  — model only, for a tick without one
+ *  • flow()     — low-lag estimate (PID feedback when KF_FEEDBACK)
+ *  • vpr()      — k · VPR; the caller's kR times it is µL per rev
+ *  Fixed 2×2 algebra written out: ~40 float ops per tick, no sqrt.
+ */
+
+#include <stdint.h>
+#include "../../include/config.hpp"
+
+class FlowKalman {
+public:
+    FlowKalman() { reset(); }
+
+    void  update (float u_uLmin, float z_uLmin, uint32_t dt_us);
+    void  predict(float u_uLmin, uint32_t dt_us);
+    void  reset();
+
+    float flow()    const { return _q; }
+    float gain()    const { return _k; }
+    float vpr()     const { return _k * VPR; }
+    float flowVar() const { return _p11; }
+    float gainVar() const { return _p22; }
+    float innov()   const { return _innov; }       // last z − q̂, µL/min
+
+private:
+    float _q, _k;
+    float _p11, _p12, _p22;                         // symmetric covariance
+    float _innov;
+};
@@ -8,7 +8,6 @@
  #include "../../include/_include.hpp"  // EXP_KP_*, EXP_KI_*, EXP_KD_*
  #include <math.h>
  
- #ifdef ENABLE_GAIN
  /**
   * @brief exponentialFunctionReciprocal
   *
@@ -78,5 +77,4 @@
                                           EXP_KD_B, 
                                           EXP_KD_C);
  }
- 
- #endif
\ No newline at end of file
+ 
\ No newline at end of file
@@ -0,0 +1,191 @@
+/*  grav_cal.cpp – gravimetric point sequencer and mass-slope fit
+ */
+
+#include "grav_cal.hpp"
+#include "../cal_curve/cal_curve.hpp"
+#include "../../include/_include.hpp"          // GCAL_*, RATE_*, CAL_MAX_PAIRS
+
+namespace GravCal {
+
+/* ───────── module state ───────── */
+static Phase    gPhase   = Phase::IDLE;
+static Fault    gFault   = Fault::NONE;
+static uint8_t  gPending = 0;           // > 0 ⇒ start on next tick
+static bool     gAbort   = false;
+
+static Point    gPts[CAL_MAX_PAIRS];
+static uint8_t  gN       = 0;
+static uint8_t  gK       = 0;           // point in SETTLE / MEASURE
+static uint8_t  gLast    = 0;           // point of the last POINT event
+static uint32_t gT0      = 0;           // start of point gK
+static uint32_t gLastWeigh = 0;
+
+/* sensor window of point gK */
+static double   gSumInd  = 0, gSumK = 0;
+static uint32_t gNInd    = 0;
+
+/* mass window of the point waiting on the balance (gPend < 0: none) */
+static int8_t   gPend    = -1;
+static uint32_t gMassT0  = 0;
+static float    gPendK   = 1.0f;        // mean temperature gain of that point
+static uint16_t gMassN   = 0;
+static double   gSt = 0, gSm = 0, gStt = 0, gStm = 0;
+static bool     gPointDue = false;      // a pair was fitted since last tick
+
+/* ───────── helpers ───────── */
+static Event fail(Fault f)
+{
+    gFault   = f;
+    gPhase   = Phase::FAILED;
+    gPend    = -1;
+    CalCurve::load();                   // back to the stored curve
+    return Event::FAILED;
+}
+
+static void beginPoint(uint8_t k, uint32_t now)
+{
+    gK = k;
+    gT0 = now;
+    gSumInd = gSumK = 0; gNInd = 0;
+    gPhase = Phase::SETTLE;
+}
+
+/* least-squares mass slope → flow; the reference is expressed at
+   sensor gain 1 so the curve and the temperature gain compose    */
+static void closeMass()
+{
+    Point& p   = gPts[gPend];
+    p.readings = gMassN;
+    p.ok       = false;
+
+    double den = gMassN * gStt - gSt * gSt;
+    if (gMassN >= GCAL_MIN_READINGS && den > 0.0) {
+        double g_per_ms = (gMassN * gStm - gSt * gSm) / den;
+        p.ref = static_cast<float>(g_per_ms * 60'000.0 * 1000.0 / FLUID_DENSITY_G_ML) / gPendK;
+        p.ok  = CalCurve::add(p.ind, p.ref);
+    }
+    gLast     = gPend;
+    gPend     = -1;
+    gPointDue = true;
+}
+
+/* opened with the sensor window; it trails it by the balance lag */
+static void openMass(uint32_t now)
+{
+    gPend   = gK;
+    gMassT0 = now + GCAL_BAL_LAG_MS;
+    gPendK  = 1.0f;
+    gMassN  = 0;
+    gSt = gSm = gStt = gStm = 0;
+}
+
+/* ───────── requests ───────── */
+bool request(uint8_t points)
+{
+    if (active() || points < 2 || points > CAL_MAX_PAIRS) return false;
+    gPending = points;
+    return true;
+}
+
+void abort() { if (active() || gPending) gAbort = true; }
+
+void weigh(float g, uint32_t t)
+{
+    if (!active()) return;
+    gLastWeigh = t;
+    if (gPend < 0 || static_cast<int32_t>(t - gMassT0) < 0) return;
+
+    if (t - gMassT0 > GCAL_WINDOW_MS) { closeMass(); return; }
+
+    double x = static_cast<double>(t - gMassT0);     // ms into the window
+    ++gMassN;
+    gSt  += x;      gSm  += g;
+    gStt += x * x;  gStm += x * g;
+}
+
+/* ───────── per-tick sequencer ───────── */
+Event tick(const Sample& ind, float kS, bool running, uint32_t now)
+{
+    if (gAbort) {
+        gAbort = false; gPending = 0;
+        if (gPhase == Phase::IDLE || gPhase == Phase::DONE ||
+            gPhase == Phase::FAILED) return Event::NONE;
+        return fail(Fault::ABORTED);
+    }
+
+    if (!active()) {
+        if (!gPending) return Event::NONE;
+        gN = gPending; gPending = 0;
+        for (uint8_t i = 0; i < gN; ++i) {
+            gPts[i]    = Point{};
+            gPts[i].sp = RATE_MIN_UL_MIN +
+                         i * float(RATE_MAX_UL_MIN - RATE_MIN_UL_MIN) / (gN - 1);
+        }
+        CalCurve::clear();              // pairs are uncorrected: start flat
+        gFault     = Fault::NONE;
+        gPend      = -1;
+        gPointDue  = false;
+        gLastWeigh = now;
+        beginPoint(0, now);
+        return Event::STARTED;
+    }
+
+    if (!running)                                   return fail(Fault::PUMP_OFF);
+    if (now - gLastWeigh > GCAL_BAL_TIMEOUT_MS)     return fail(Fault::NO_BALANCE);
+    if (gPointDue) { gPointDue = false;             return Event::POINT; }
+
+    switch (gPhase) {
+        case Phase::SETTLE:
+            if (now - gT0 < GCAL_SETTLE_MS) break;
+            if (gPend >= 0) closeMass();            // balance fell behind
+            openMass(now);
+            gPhase = Phase::MEASURE;
+            break;
+
+        case Phase::MEASURE:
+            if (ind.good()) { gSumInd += ind.value; gSumK += kS; ++gNInd; }
+            if (now - gT0 < GCAL_SETTLE_MS + GCAL_WINDOW_MS) break;
+
+            gPts[gK].ind = gNInd ? static_cast<float>(gSumInd / gNInd) : 0.0f;
+            gPendK       = gNInd ? static_cast<float>(gSumK   / gNInd) : 1.0f;
+            if (gK + 1 < gN) beginPoint(gK + 1, now);
+            else             gPhase = Phase::TAIL;
+            break;
+
+        case Phase::TAIL:
+            if (gPend >= 0) break;                  // last mass window open
+            {
+                uint8_t ok = 0;
+                for (uint8_t i = 0; i < gN; ++i) ok += gPts[i].ok;
+                if (ok < 2) return fail(Fault::TOO_FEW);
+            }
+            CalCurve::save();
+            gPhase = Phase::DONE;
+            return Event::FINISHED;
+
+        default: break;
+    }
+    return Event::NONE;
+}
+
+/* ───────── accessors ───────── */
+float setpoint()
+{
+    if (!active()) return 0.0f;
+    return gPhase == Phase::TAIL ? gPts[gN - 1].sp : gPts[gK].sp;
+}
+
+bool active()
+{
+    return gPhase == Phase::SETTLE || gPhase == Phase::MEASURE ||
+           gPhase == Phase::TAIL;
+}
+
+Phase        phase()            { return gPhase; }
+Fault        fault()            { return gFault; }
+uint8_t      points()           { return gN; }
+uint8_t      current()          { return gK; }
+const Point& point(uint8_t i)   { return gPts[i < CAL_MAX_PAIRS ? i : 0]; }
+const Point& last()             { return gPts[gLast]; }
+
+}   // namespace GravCal
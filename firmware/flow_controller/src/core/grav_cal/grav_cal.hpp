@@ -0,0 +1,61 @@
+#pragma once
+/*  grav_cal.hpp ─ automated gravimetric calibration
+ *  -------------------------------------------------
+ *  Steps the set-point through n points (RATE_MIN … RATE_MAX) and,
+ *  for each, pairs the mean *uncorrected* sensor flow with the
+ *  balance flow (least-squares mass slope / FLUID_DENSITY_G_ML).
+ *  Every pair goes straight into CalCurve; the curve is saved when
+ *  at least two points were accepted, otherwise the stored one is
+ *  reloaded.
+ *
+ *  Pipelined: the balance sees the flow GCAL_BAL_LAG_MS late, so a
+ *  point's balance window is its sensor window shifted by the lag
+ *  and is still being filled while the next point settles:
+ *
+ *    sp k    |── settle ──|══ sensor k ══|── settle k+1 ──|══ …
+ *    balance               |══ mass k ══|
+ *                          ↑ +lag        ↑ +lag → pair k fitted
+ *
+ *  The pump keeps the last point's rate until its mass window closes.
+ *  Losing the balance for GCAL_BAL_TIMEOUT_MS, or the pump being
+ *  switched off, fails the run.
+ */
+
+#include <stdint.h>
+#include "../sample/sample.hpp"
+
+namespace GravCal {
+
+enum class Phase : uint8_t { IDLE = 0, SETTLE, MEASURE, TAIL, DONE, FAILED };
+enum class Event : uint8_t { NONE = 0, STARTED, POINT, FINISHED, FAILED };
+enum class Fault : uint8_t { NONE = 0, ABORTED, PUMP_OFF, NO_BALANCE, TOO_FEW };
+
+struct Point {
+    float    sp{0};             // commanded, µL/min
+    float    ind{0};            // mean uncorrected sensor flow
+    float    ref{0};            // balance flow, in sensor-gain-1 units
+    uint16_t readings{0};       // balance readings in the mass window
+    bool     ok{false};         // accepted by CalCurve
+};
+
+/* requests (serial); picked up on the next tick() */
+bool  request(uint8_t points);      // 2 … CAL_MAX_PAIRS
+void  abort();
+
+/* balance readings, stamped on the control timebase (ms) */
+void  weigh(float g, uint32_t t_ms);
+
+/* call once per control tick; ind = sensor flow before CalCurve,
+   kS = temperature gain applied after it                        */
+Event tick(const Sample& ind, float kS, bool running, uint32_t now_ms);
+
+float        setpoint();            // µL/min while active()
+bool         active();
+Phase        phase();
+Fault        fault();
+uint8_t      points();
+uint8_t      current();             // point being settled / measured
+const Point& point(uint8_t i);
+const Point& last();                // the most recent POINT
+
+}   // namespace GravCal
@@ -0,0 +1,85 @@
+#include "occlusion.hpp"
+#include <math.h>
+
+bool OcclusionDetector::update(float cmdSps, uint32_t dOdo, const Sample& s, uint32_t dt_us)
+{
+    ++_cur.n;
+    _cur.cmd_uL += cmdSps * (dt_us * 1e-6f) * UL_PER_STEP;
+    _cur.odo_uL += dOdo * UL_PER_STEP;
+    _cur.us     += dt_us;
+    if (s.good()) {                 // bad ticks count on neither side
+        _cur.exp_uL  += dOdo * UL_PER_STEP;
+        _cur.meas_uL += s.value * (dt_us / 60.0e6f);
+        _cur.good_us += dt_us;
+        ++_cur.good;
+    }
+    if (_cur.n < OCCL_BLOCK_TICKS) return false;
+
+    State prev = _state;
+    closeBlock();
+    return _state != prev;
+}
+
+void OcclusionDetector::closeBlock()
+{
+    /* a commanded rate step re-arms the blanking window; a drive that
+       stops stepping on its own is not one                          */
+    float blkRate = _cur.us ? _cur.cmd_uL * 60.0e6f / _cur.us : 0.0f;
+    float ref     = fmaxf(fmaxf(blkRate, _lastBlkRate), OCCL_MIN_EXP_UL_MIN);
+    if (fabsf(blkRate - _lastBlkRate) > OCCL_STEP_FRAC * ref)
+        _blank = OCCL_SETTLE_BLOCKS;
+    _lastBlkRate = blkRate;
+
+    _blk[_head] = _cur;
+    _head = (_head + 1) % OCCL_BLOCKS;
+    if (_filled < OCCL_BLOCKS) ++_filled;
+    _cur = Block{};
+
+    if (_blank) { --_blank; _candN = 0; return; }
+    if (_filled < OCCL_BLOCKS) return;
+
+    State v = classify();
+    if (v != _cand) { _cand = v; _candN = 0; }
+    if (v == _state || ++_candN < OCCL_HOLD_BLOCKS) return;
+
+    _state = v;
+    _candN = 0;
+    if (v != State::OK) ++_events;
+}
+
+OcclusionDetector::State OcclusionDetector::classify()
+{
+    float cmd = 0, odo = 0, exp = 0, meas = 0;
+    uint32_t all = 0, us = 0, good = 0, n = 0;
+    for (const Block& b : _blk) {
+        cmd += b.cmd_uL; odo += b.odo_uL;
+        exp += b.exp_uL; meas += b.meas_uL;
+        all += b.us; us += b.good_us; good += b.good; n += b.n;
+    }
+
+    /* drive not stepping: odometer against command, sensor not needed */
+    if (all && cmd * 60.0e6f / all >= OCCL_MIN_EXP_UL_MIN && odo < STALL_RATIO * cmd) {
+        _expRate  = odo * 60.0e6f / all;
+        _measRate = us ? meas * 60.0e6f / us : 0.0f;
+        _ratio    = odo / cmd;
+        return State::STALLED;
+    }
+
+    /* too few good samples to judge: keep the current verdict */
+    if (!n || good < OCCL_MIN_GOOD * n || !us) return _state;
+
+    _expRate  = exp  * 60.0e6f / us;
+    _measRate = meas * 60.0e6f / us;
+    _ratio    = exp > 0 ? meas / exp : 0.0f;
+
+    if (_expRate < OCCL_MIN_EXP_UL_MIN)
+        return _measRate > FREEFLOW_UL_MIN ? State::FREE_FLOW : State::OK;
+    if (_ratio < OCCL_RATIO)     return State::OCCLUDED;      // down to 0
+    if (_ratio > FREEFLOW_RATIO) return State::FREE_FLOW;
+    return State::OK;
+}
+
+void OcclusionDetector::reset()
+{
+    *this = OcclusionDetector{};
+}
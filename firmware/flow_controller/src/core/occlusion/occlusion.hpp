@@ -0,0 +1,65 @@
+#pragma once
+/*  occlusion.hpp ─ delivery monitor: emitted steps vs. measured flow
+ *  ----------------------------------------------------------------
+ *  • update()  — once per tick: commanded rate, odometer delta and
+ *                the raw Sample
+ *  • state()   — OK | OCCLUDED | STALLED | FREE_FLOW
+ *
+ *  STALLED is the drive not stepping: the odometer advances by less
+ *  than STALL_RATIO of the commanded rate (driver fault, asleep, hard
+ *  stop).  It needs no sensor.  Everything downstream of the STEP
+ *  pulses – a blocked line, up to a ratio of 0, or a rotor that slips
+ *  while pulses still arrive – reads as OCCLUDED; the sensor alone
+ *  cannot tell those two apart.
+ *
+ *  Expected volume is Δodometer · UL_PER_STEP, measured volume is
+ *  Σ Q·dt of good samples; both are summed over the same good ticks
+ *  in blocks of OCCL_BLOCK_TICKS and compared over a sliding window of
+ *  OCCL_BLOCKS, so sensor lag and noise hit both sides alike.  A
+ *  verdict must repeat for OCCL_HOLD_BLOCKS before the state flips,
+ *  and classification is blanked for OCCL_SETTLE_BLOCKS after a step
+ *  in the commanded rate (start, stop, set-point jump) while the
+ *  tubing catches up.
+ *  Per tick: a handful of adds; per block: one O(OCCL_BLOCKS) sum.
+ */
+
+#include <stdint.h>
+#include "../../include/config.hpp"
+#include "../sample/sample.hpp"
+
+class OcclusionDetector {
+public:
+    enum class State : uint8_t { OK, OCCLUDED, STALLED, FREE_FLOW };
+
+    /* returns true on the tick the state changes */
+    bool  update(float cmdSps, uint32_t dOdo, const Sample& s, uint32_t dt_us);
+    void  reset();
+
+    State state()       const { return _state; }
+    float ratio()       const { return _ratio; }        // meas / exp over window
+    float expRate()     const { return _expRate; }      // µL/min over window
+    float measRate()    const { return _measRate; }     // µL/min over window
+    uint32_t events()   const { return _events; }
+
+private:
+    struct Block {
+        float    cmd_uL, odo_uL;            // every tick
+        float    exp_uL, meas_uL;           // good ticks only
+        uint32_t us, good_us;
+        uint8_t  good, n;
+    };
+
+    State classify();
+    void  closeBlock();
+
+    Block    _blk[OCCL_BLOCKS]{};
+    Block    _cur{};
+    uint8_t  _head{0}, _filled{0};
+    uint8_t  _blank{OCCL_SETTLE_BLOCKS};
+    float    _lastBlkRate{0};
+
+    State    _state{State::OK}, _cand{State::OK};
+    uint8_t  _candN{0};
+    float    _ratio{1}, _expRate{0}, _measRate{0};
+    uint32_t _events{0};
+};
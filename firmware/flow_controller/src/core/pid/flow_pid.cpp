@@ -0,0 +1,63 @@
+#include "flow_pid.hpp"
+#include "../../include/config.hpp"    // PID_SP_WEIGHT, PID_DERIV_FILTER_ALPHA
+#include <math.h>
+
+float FlowPid::compute(float sp, float y, float ff, float dt)
+{
+    if (!(dt > 0.0f)) return _u;
+    if (!_primed) start(y);
+
+    /* reference model: what the tube lets the flow do */
+    _r += (sp - _r) * (1.0f - expf(-dt / _tau));
+
+    /* P on weighted set-point, D on measurement (no set-point kick) */
+    _p = _g.kp * (PID_SP_WEIGHT * _r - y);
+    float dy = (y - _yPrev) / dt;
+    _yPrev = y;
+    _dF = PID_DERIV_FILTER_ALPHA * _dF + (1.0f - PID_DERIV_FILTER_ALPHA) * dy;
+    _d  = -_g.kd * _dF;
+
+    if (_manual) {                  // bumpless: carry on from the held output
+        _i = _iPrev = _u - ff - _p - _d;
+        _manual = false;
+    } else {
+        _iPrev = _i;
+        _i += _g.ki * (_r - y) * dt;
+    }
+
+    _v = ff + _p + _i + _d;
+    _u = _v < _lo ? _lo : (_v > _hi ? _hi : _v);
+    return _u;
+}
+
+/* The integrator unwinds its own share only: a shortfall that
+   ff + P alone would cause (a long brake, a hard rate ceiling)
+   never drives it past zero, so once the limit lifts the output
+   is back at the feed-forward at once.                          */
+void FlowPid::track(float achieved, float dt)
+{
+    if (_manual || !(dt > 0.0f)) return;
+    float i = _i + (achieved - _v) * dt / _tt;
+    if (achieved < _v)      { float f = _iPrev < 0 ? _iPrev : 0; _i = i > f ? i : f; }
+    else if (achieved > _v) { float f = _iPrev > 0 ? _iPrev : 0; _i = i < f ? i : f; }
+    _v = achieved;
+}
+
+void FlowPid::hold(float u)
+{
+    _u = u;
+    _manual = true;
+}
+
+/* A new run owes nothing to the last one: its integrator (and a
+   hold() still pending from it) would be re-applied at whatever
+   set-point the pump is switched on to.                         */
+void FlowPid::start(float y)
+{
+    _r = y;
+    _yPrev = y;
+    _dF = 0.0f;
+    _i = _iPrev = 0.0f;
+    _manual = false;
+    _primed = true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+/*  flow_pid.hpp ─ flow-loop PID with actuator tracking
+ *  ---------------------------------------------------
+ *    u = ff + Kp·(b·r − y) + I − Kd·ẏ        clamped to [lo, hi]
+ *
+ *  • ff          — feed-forward from the caller (set-point / delivery
+ *                  gain), so I only holds the residual correction
+ *  • r           — the set-point through a first-order reference
+ *                  model (τ = tube compliance): the integrator sees
+ *                  the error against the response the plant can
+ *                  give, not the lag every set-point change or
+ *                  start-up produces
+ *  • track()     — back-calculation: I += (a − v)·dt / Tt, with a the
+ *                  output the actuator really delivered and v the
+ *                  unclamped PID sum.  Any limit downstream – output
+ *                  clamp, dose brake, step-rate ceiling, period
+ *                  quantisation – unwinds the integrator the same way
+ *  • hold()      — manual: the output is forced; the next compute()
+ *                  re-seeds I so the output carries on from it
+ *  • start()     — bumpless enable: reference model restarts at the
+ *                  measured flow, derivative forgets its history,
+ *                  I and a pending hold() are cleared
+ *  dt is explicit (s) on every call; nothing reads a clock.
+ */
+
+#include <stdint.h>
+
+class FlowPid {
+public:
+    struct Gains { float kp, ki, kd; };
+
+    FlowPid(Gains g, float lo, float hi, float refTau_s, float track_s)
+        : _g(g), _lo(lo), _hi(hi), _tau(refTau_s), _tt(track_s) {}
+
+    float compute(float sp, float y, float ff, float dt_s);  // → clamped output
+    void  track(float achieved, float dt_s);
+    void  hold(float u);
+    void  start(float y);
+
+    void  setGains(Gains g)        { _g = g; }
+    void  setLimits(float lo, float hi) { _lo = lo; _hi = hi; }
+
+    float output() const { return _u; }
+    float pTerm()  const { return _p; }
+    float iTerm()  const { return _i; }
+    float dTerm()  const { return _d; }
+    float ref()    const { return _r; }
+
+private:
+    Gains _g;
+    float _lo, _hi, _tau, _tt;
+
+    float _r{0}, _yPrev{0}, _dF{0};
+    float _p{0}, _i{0}, _d{0}, _iPrev{0};
+    float _v{0}, _u{0};             // unclamped sum, clamped output
+    bool  _manual{false}, _primed{false};
+};
@@ -7,7 +7,6 @@
  #include "../../include/_include.hpp"  // PID_DERIV_FILTER_ALPHA
  #include <Arduino.h>
  
-#ifdef ENABLE_PID
 
  // PID gains
  static float Kp = 0.0f;
@@ -22,8 +21,8 @@
  float integralTerm = 0.0f;
  
  // Tracking variables for normal PID
- static float lastError         = 0.0f;
- static unsigned long lastTimeNormal = 0;
+ static float    lastError      = 0.0f;
+ static uint64_t lastTimeNormal = 0;      // µs (State::nowUs)
  
  // Externally referenced anti-windup data
  float g_lastIntegralIncrement = 0.0f;
@@ -38,7 +37,7 @@
    dErrorFilteredNormal   = 0.0f;
    integralTerm           = 0.0f;
    lastError              = 0.0f;
-   lastTimeNormal         = millis();
+   lastTimeNormal         = State::nowUs();
    g_lastIntegralIncrement = 0.0f;
    g_lastErrorForAW        = 0.0f;
  }
@@ -61,10 +60,10 @@
                        float &iTermOut,
                        float &dTermOut)
  {
-   unsigned long now = millis();
-   float dt = (now - lastTimeNormal) / 1000.0f;
+   uint64_t now = State::nowUs();
+   float dt = (now - lastTimeNormal) * 1e-6f;
    if (dt <= 0.0f) {
-     dt = 0.001f;
+     dt = 1e-6f;                          // same-µs call: avoid /0 only
    }
    lastTimeNormal = now;
  
@@ -98,5 +97,4 @@
  
    return rawOutput;
  }
- 
- #endif // ENABLE_PID
\ No newline at end of file
+ 
\ No newline at end of file
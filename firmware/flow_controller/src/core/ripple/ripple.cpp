@@ -0,0 +1,181 @@
+/*  ripple.cpp – angle bins, revolution accumulator, rate modulation
+ */
+
+#include "ripple.hpp"
+#include "../../include/_include.hpp"          // RIPPLE_*, LOOP_INTERVAL_MS
+
+namespace Ripple {
+
+/* ───────── module state ───────── */
+static float    gGain[RIPPLE_BINS];
+static bool     gInit    = false;
+static bool     gOn      = false;
+static uint16_t gRevs    = 0;
+
+/* per-tick command history: interval k runs from odo[k] at base·scale */
+struct Cmd { uint32_t odo; float base, scale; bool mod; };
+static constexpr uint8_t HIST = 8;
+static_assert(RIPPLE_LAG_TICKS + 1 < HIST, "lag exceeds command history");
+static Cmd      gHist[HIST];
+static uint8_t  gHead    = 0;            // next slot
+static uint8_t  gFill    = 0;
+
+/* revolution being accumulated: flow / base and the applied scale */
+static double   gSum[RIPPLE_BINS];
+static float    gSumS[RIPPLE_BINS];
+static uint16_t gCnt[RIPPLE_BINS];
+static bool     gRevMod  = false;        // modulation applied all revolution
+static uint32_t gRev     = 0;
+static bool     gRevOk   = false;        // false ⇒ discard at the boundary
+static float    gBaseMin = 0, gBaseMax = 0;
+
+/* ───────── helpers ───────── */
+static inline void ensure() { if (!gInit) clear(); }
+
+static void resetRev(uint32_t rev)
+{
+    for (uint8_t b = 0; b < RIPPLE_BINS; ++b) { gSum[b] = 0; gSumS[b] = 0; gCnt[b] = 0; }
+    gRev     = rev;
+    gRevOk   = true;
+    gRevMod  = active();
+    gBaseMin = 1e30f; gBaseMax = 0;
+}
+
+/* gain at a rotor position, lerped between bin centres (wraps) */
+static float lookup(uint32_t odo)
+{
+    constexpr float BINS_PER_STEP = float(RIPPLE_BINS) / RIPPLE_STEPS_PER_REV;
+    float x = (odo % RIPPLE_STEPS_PER_REV) * BINS_PER_STEP - 0.5f;
+    if (x < 0) x += RIPPLE_BINS;
+    uint8_t i = static_cast<uint8_t>(x);
+    uint8_t j = (i + 1) % RIPPLE_BINS;
+    float   f = x - i;
+    return gGain[i] + (gGain[j] - gGain[i]) * f;
+}
+
+/* A complete revolution.  The bins hold the flow at the sensor, i.e.
+   what entered the tube through its first-order lag; that is undone
+   per bin, x = y + τ·dy/dt, with dt the time the rotor took across
+   the bin at the applied rate.  x normalised to mean 1 is then the
+   residual ripple: with the modulation on, g is scaled by it until
+   the output is flat; with it off, x is g itself and g moves toward
+   it.  Either way g converges on the delivery ripple, not on its
+   attenuated image at the sensor.                                   */
+static void closeRev()
+{
+    if (!gRevOk || gBaseMax > gBaseMin * (1.0f + RIPPLE_STEADY_FRAC)) return;
+
+    float y[RIPPLE_BINS], sc[RIPPLE_BINS];
+    for (uint8_t b = 0; b < RIPPLE_BINS; ++b) {
+        if (!gCnt[b]) return;                       // bin skipped: too fast
+        y[b]  = static_cast<float>(gSum[b] / gCnt[b]);
+        sc[b] = gSumS[b] / gCnt[b];
+    }
+
+    constexpr float STEPS_PER_BIN = float(RIPPLE_STEPS_PER_REV) / RIPPLE_BINS;
+    const float base = 0.5f * (gBaseMin + gBaseMax);
+    float  x[RIPPLE_BINS];
+    double m = 0;
+    for (uint8_t b = 0; b < RIPPLE_BINS; ++b) {
+        float dt = STEPS_PER_BIN / (base * sc[b]);  // s across this bin
+        float dy = y[(b + 1) % RIPPLE_BINS] - y[(b + RIPPLE_BINS - 1) % RIPPLE_BINS];
+        x[b] = y[b] + RIPPLE_TUBE_TAU_S * dy / (2.0f * dt);
+        m   += x[b];
+    }
+    m /= RIPPLE_BINS;
+    if (!(m > 0)) return;
+
+    double mg = 0;
+    for (uint8_t b = 0; b < RIPPLE_BINS; ++b) {
+        float e = static_cast<float>(x[b] / m);
+        float g = gRevMod ? gGain[b] * (1.0f + RIPPLE_LEARN_RATE * (e - 1.0f))
+                          : gGain[b] + RIPPLE_LEARN_RATE * (e - gGain[b]);
+        gGain[b] = constrain(g, RIPPLE_GAIN_MIN, RIPPLE_GAIN_MAX);
+        mg += gGain[b];
+    }
+    mg /= RIPPLE_BINS;                              // clamping can shift it
+    for (uint8_t b = 0; b < RIPPLE_BINS; ++b) gGain[b] /= static_cast<float>(mg);
+    if (gRevs < 0xFFFF) ++gRevs;
+}
+
+/* ───────── per tick ───────── */
+void observe(uint32_t odo, float flow, bool good)
+{
+    ensure();
+    if (gFill <= RIPPLE_LAG_TICKS) return;          // history too short
+
+    /* interval that the sensor is reporting on, and where it ended */
+    uint8_t k  = (gHead + HIST - 1 - RIPPLE_LAG_TICKS) % HIST;
+    uint8_t k1 = (k + 1) % HIST;
+    const Cmd& c = gHist[k];
+    uint32_t end = RIPPLE_LAG_TICKS ? gHist[k1].odo : odo;
+    uint32_t mid = c.odo + (end - c.odo) / 2;
+
+    uint32_t rev = mid / RIPPLE_STEPS_PER_REV;
+    if (rev != gRev) { closeRev(); resetRev(rev); }
+
+    if (!good || !(c.base > 0)) { gRevOk = false; return; }
+    if (c.base < gBaseMin) gBaseMin = c.base;
+    if (c.base > gBaseMax) gBaseMax = c.base;
+
+    uint8_t b = static_cast<uint8_t>(
+        (mid % RIPPLE_STEPS_PER_REV) * RIPPLE_BINS / RIPPLE_STEPS_PER_REV);
+    if (c.mod != gRevMod) gRevOk = false;           // toggled mid-revolution
+    gSum[b]  += flow / c.base;
+    gSumS[b] += c.scale;
+    ++gCnt[b];
+}
+
+double command(uint32_t odo, double baseSps)
+{
+    ensure();
+    float scale = 1.0f;
+    bool  mod   = active() && baseSps > 0;
+    if (mod) {
+        /* rotor position half a tick ahead */
+        uint32_t ahead = static_cast<uint32_t>(baseSps * LOOP_INTERVAL_MS / 2000.0);
+        scale = 1.0f / lookup(odo + ahead);
+    }
+    gHist[gHead] = Cmd{odo, static_cast<float>(baseSps), scale, mod};
+    gHead = (gHead + 1) % HIST;
+    if (gFill < HIST) ++gFill;
+    return baseSps * scale;
+}
+
+void idle()
+{
+    gFill  = 0;
+    gRevOk = false;                                 // partial revolution is stale
+}
+
+/* ───────── control ───────── */
+void enable(bool on) { gOn = on; }
+bool enabled()       { return gOn; }
+bool active()        { return gOn && gRevs >= RIPPLE_MIN_REVS; }
+
+void clear()
+{
+    for (uint8_t b = 0; b < RIPPLE_BINS; ++b) gGain[b] = 1.0f;
+    gRevs  = 0;
+    gInit  = true;
+    resetRev(0);
+    gRevOk = false;
+}
+
+/* ───────── reporting ───────── */
+uint16_t revs() { return gRevs; }
+
+float gainAt(uint8_t b) { ensure(); return gGain[b < RIPPLE_BINS ? b : 0]; }
+
+float peakToPeak()
+{
+    ensure();
+    float lo = gGain[0], hi = gGain[0];
+    for (uint8_t b = 1; b < RIPPLE_BINS; ++b) {
+        if (gGain[b] < lo) lo = gGain[b];
+        if (gGain[b] > hi) hi = gGain[b];
+    }
+    return hi - lo;
+}
+
+}   // namespace Ripple
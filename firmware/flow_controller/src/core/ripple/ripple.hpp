@@ -0,0 +1,45 @@
+#pragma once
+/*  ripple.hpp – roller-synchronous flow-ripple compensation
+ *  --------------------------------------------------------
+ *  Every roller that lifts off the tube takes a bite out of the
+ *  delivered flow, so the volume per step is a function of rotor
+ *  angle, g(θ) with mean 1.  The angle is the step odometer modulo
+ *  one revolution; the table holds g on RIPPLE_BINS bins.
+ *
+ *  observe() – once per tick, the calibrated sensor flow.  It is
+ *              booked, divided by the base step rate, to the bin the
+ *              rotor was in RIPPLE_LAG_TICKS before.  A revolution
+ *              with every bin seen, no bad sample, a steady base rate
+ *              and one modulation state throughout moves g.
+ *  command() – base step rate → rate for the coming tick: base / g
+ *              at the angle half a tick ahead, so the instantaneous
+ *              flow, not only its average, comes out flat.
+ *
+ *  The tube smooths the ripple before the sensor sees it, so each
+ *  revolution has the tube lag (RIPPLE_TUBE_TAU_S) undone first.
+ *  With the modulation off that gives g directly; with it on, what
+ *  is left is the residual, and g is scaled by it until the flow is
+ *  flat.  A time constant mis-set by 0.6 … 1.6× (tools/sim) then
+ *  changes how fast g learns, not where it settles.  The table is RAM only: the odometer – and thus the
+ *  angle reference – restarts at power-up.
+ */
+
+#include <stdint.h>
+
+namespace Ripple {
+
+void   observe(uint32_t odo, float flow_uLmin, bool good);
+double command(uint32_t odo, double baseSps);   // pump running
+void   idle();                                  // pump off: drop the history
+
+void   enable(bool on);                         // modulation (learning always runs)
+bool   enabled();
+bool   active();                                // enabled and learned
+void   clear();                                 // flat table
+
+/* reporting */
+uint16_t revs();                                // accepted revolutions
+float    gainAt(uint8_t bin);
+float    peakToPeak();                          // max g − min g
+
+}   // namespace Ripple
@@ -0,0 +1,60 @@
+#pragma once
+/*  sample.hpp ─ flow sample with acquisition time and quality
+ *  ----------------------------------------------------------
+ *  Produced by every Hal::FlowSensor back-end and carried through
+ *  the chain, so each stage can pick its own policy for bad input:
+ *    • LPF / PID      — hold   (bad samples never enter; output HELD)
+ *    • VolumeTracker  — bridge link gaps by interpolation, drop air
+ *    • BubbleGuard    — AIR bit
+ *    • SampleStats    — good fraction per window (telemetry "s_good")
+ */
+
+#include <stdint.h>
+#include "../../include/config.hpp"     // SLF_FLAG_*
+
+namespace SampleQ {
+constexpr uint8_t WARMUP    = 0x01;     // start-up discard
+constexpr uint8_t IO_ERR    = 0x02;     // bus read failed
+constexpr uint8_t OFFLINE   = 0x04;     // link stopped or recovering
+constexpr uint8_t AIR       = 0x08;     // air-in-line
+constexpr uint8_t HIGH_FLOW = 0x10;     // sensor out of range
+constexpr uint8_t HELD      = 0x20;     // value repeated from an earlier sample
+
+constexpr uint8_t LINK      = WARMUP | IO_ERR | OFFLINE;   // no fresh reading
+
+/* SF06-LF status word → quality bits */
+constexpr uint8_t fromSlf(uint16_t flags)
+{
+    return ((flags & SLF_FLAG_AIR_IN_LINE) ? AIR       : 0) |
+           ((flags & SLF_FLAG_HIGH_FLOW)   ? HIGH_FLOW : 0);
+}
+}   // namespace SampleQ
+
+struct Sample {
+    float    value = 0.0f;      // µL/min
+    uint64_t t_us  = 0;         // acquisition time of value (State::nowUs)
+    uint8_t  q     = 0;         // SampleQ bits, 0 = good
+
+    bool good() const { return q == 0; }
+};
+
+/* good-sample fraction over consecutive blocks of `window` samples */
+class SampleStats {
+public:
+    explicit SampleStats(uint16_t window) : _window(window ? window : 1) {}
+
+    void record(const Sample& s)
+    {
+        if (s.good()) ++_good;
+        if (++_n < _window) return;
+        _frac = static_cast<float>(_good) / _n;
+        _n = _good = 0;
+    }
+
+    float goodFrac() const { return _frac; }    // last complete window
+
+private:
+    uint16_t _window;
+    uint16_t _n{0}, _good{0};
+    float    _frac{1.0f};
+};
@@ -0,0 +1,154 @@
+/*  sp_program.cpp – set-point program table & tick executor
+ *  ---------------------------------------------------------
+ *  All timing is in control ticks (LOOP_INTERVAL_MS each).
+ */
+
+#include "sp_program.hpp"
+#include "../../include/_include.hpp"          // LOOP_INTERVAL_MS, EE_ADDR_PROGRAM
+#include <EEPROM.h>
+
+namespace Program {
+
+/* ───────── EEPROM layout ───────── */
+static constexpr uint32_t MAGIC   = 0x50524731;   // "PRG1"
+static constexpr uint8_t  VERSION = 1;
+
+struct ProgBlob {
+    uint32_t magic;
+    uint8_t  ver;
+    uint8_t  count;
+    Step     steps[MAX_STEPS];
+};
+static_assert(EE_ADDR_PROGRAM + sizeof(ProgBlob) <= EE_ADDR_TOTAL,
+              "program table overlaps totalizer ring");
+
+/* ───────── module state ───────── */
+static Step     gSteps[MAX_STEPS];
+static uint8_t  gCount   = 0;
+
+static Run      gRun     = Run::IDLE;
+static uint8_t  gIdx     = 0;
+static uint32_t gTick    = 0;       // ticks spent in current step
+static uint32_t gTicks   = 0;       // ticks the step lasts (RAMP / HOLD)
+static float    gSp      = 0.0f;    // current program set-point
+static float    gSpFrom  = 0.0f;    // SP at RAMP entry
+static float    gVolFrom = 0.0f;    // volume at DOSE entry
+static bool     gEntered = false;
+static bool     gSignal  = false;
+
+static inline uint32_t msToTicks(uint32_t ms)
+{ return (ms + LOOP_INTERVAL_MS / 2) / LOOP_INTERVAL_MS; }
+
+/* ───────── table editing ───────── */
+bool clear()
+{
+    if (active()) return false;
+    gCount = 0;
+    gRun   = Run::IDLE;
+    return true;
+}
+
+bool add(const Step& s)
+{
+    if (active() || gCount >= MAX_STEPS || s.op == Op::END) return false;
+    gSteps[gCount++] = s;
+    return true;
+}
+
+uint8_t     count()          { return gCount; }
+const Step& step(uint8_t i)  { return gSteps[i < gCount ? i : 0]; }
+
+/* ───────── EEPROM ───────── */
+bool load()
+{
+    ProgBlob blob{}; EEPROM.get(EE_ADDR_PROGRAM, blob);
+    if (blob.magic != MAGIC || blob.ver != VERSION ||
+        blob.count > MAX_STEPS) return false;
+
+    gCount = blob.count;
+    for (uint8_t i = 0; i < gCount; ++i) gSteps[i] = blob.steps[i];
+    return true;
+}
+
+void save()
+{
+    ProgBlob blob{};
+    blob.magic = MAGIC; blob.ver = VERSION; blob.count = gCount;
+    for (uint8_t i = 0; i < gCount; ++i) blob.steps[i] = gSteps[i];
+    EEPROM.put(EE_ADDR_PROGRAM, blob);
+    State::requestCommit();                    // written between ticks
+}
+
+/* ───────── execution ───────── */
+bool start(float fromSp)
+{
+    if (!gCount) return false;
+    gIdx = 0; gEntered = false; gSignal = false;
+    gSp  = fromSp;
+    gRun = Run::RUNNING;
+    return true;
+}
+
+void stop()    { if (active()) gRun = Run::IDLE; }
+void signal()  { gSignal = true; }
+
+float tick(float volume_uL)
+{
+    if (!active()) return gSp;
+
+    while (gIdx < gCount) {
+        const Step& s = gSteps[gIdx];
+
+        if (!gEntered) {                       // step entry
+            gEntered = true;
+            gTick    = 0;
+            gTicks   = msToTicks(s.ms);
+            gSpFrom  = gSp;
+            gVolFrom = volume_uL;
+            gSignal  = false;
+        }
+
+        bool done = false;
+        switch (s.op) {
+            case Op::RAMP:
+                if (gTicks) {
+                    ++gTick;
+                    gSp  = gSpFrom + (s.value - gSpFrom) *
+                                     static_cast<float>(gTick) / gTicks;
+                }
+                done = (gTick >= gTicks);
+                if (done) gSp = s.value;
+                break;
+            case Op::HOLD:
+                if (gTicks) ++gTick;
+                done = (gTick >= gTicks);
+                break;
+            case Op::DOSE:
+                done = (volume_uL - gVolFrom >= s.value);
+                break;
+            case Op::WAIT:
+                gRun = gSignal ? Run::RUNNING : Run::WAITING;
+                done = gSignal;
+                break;
+            default:
+                done = true;
+        }
+
+        if (!done) return gSp;                 // step continues next tick
+        ++gIdx; gEntered = false;
+
+        /* a timed step used up this tick; zero-length steps fall through */
+        if (gTick && gIdx < gCount) return gSp;
+    }
+
+    gRun = Run::DONE;
+    return gSp;
+}
+
+/* ───────── status ───────── */
+Run     state()       { return gRun; }
+uint8_t activeStep()  { return gIdx; }
+bool    active()      { return gRun == Run::RUNNING || gRun == Run::WAITING; }
+float   setpoint()    { return gSp; }
+
+}   // namespace Program
@@ -0,0 +1,58 @@
+#pragma once
+/*  sp_program.hpp ─ on-device set-point program (recipe) engine
+ *  ------------------------------------------------------------
+ *  A fixed table of up to MAX_STEPS steps, executed by tick():
+ *    RAMP  value=µL/min  ms=duration   linear ramp from current SP
+ *    HOLD               ms=duration   keep current SP
+ *    DOSE  value=µL                   keep SP until ΔV ≥ value
+ *    WAIT                             keep SP until signal()
+ *
+ *  tick() is called once per control tick (LOOP_INTERVAL_MS) and counts
+ *  ticks rather than wall-clock, so step timing is deterministic.
+ *  The table persists to EEPROM at EE_ADDR_PROGRAM.
+ *
+ *  End action: on DONE the caller adopts setpoint() as the user
+ *  set-point, so the pump holds the last program value; stop()
+ *  returns to the user set-point the program started from.
+ */
+
+#include <stdint.h>
+
+namespace Program {
+
+enum class Op : uint8_t { END = 0, RAMP, HOLD, DOSE, WAIT };
+enum class Run : uint8_t { IDLE = 0, RUNNING, WAITING, DONE };
+
+struct Step {
+    Op       op{Op::END};
+    float    value{0};          // µL/min (RAMP) | µL (DOSE)
+    uint32_t ms{0};             // duration (RAMP / HOLD)
+};
+
+constexpr uint8_t MAX_STEPS = 16;
+
+/* table editing (rejected while running) */
+bool  clear();
+bool  add(const Step& s);
+uint8_t     count();
+const Step& step(uint8_t i);
+
+/* EEPROM */
+bool  load();
+void  save();                       // stage; committed between ticks
+
+/* execution */
+bool  start(float fromSp);      // false if table empty
+void  stop();
+void  signal();                 // releases a WAIT step
+
+/* call once per control tick; returns the set-point to track */
+float tick(float volume_uL);
+
+/* status */
+Run     state();
+uint8_t activeStep();
+bool    active();               // RUNNING or WAITING
+float   setpoint();
+
+}   // namespace Program
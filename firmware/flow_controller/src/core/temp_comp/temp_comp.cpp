@@ -0,0 +1,129 @@
+/*  temp_comp.cpp – temperature grid, lookup, learning, persistence
+ *  ----------------------------------------------------------------
+ */
+
+#include "temp_comp.hpp"
+#include "../../include/_include.hpp"          // TC_*, EE_ADDR_TCOMP
+#include <EEPROM.h>
+
+namespace TempComp {
+
+/* ───────── EEPROM layout ───────── */
+static constexpr uint32_t MAGIC   = 0x54435031;   // "TCP1"
+static constexpr uint8_t  VERSION = 1;
+
+struct TcBlob {
+    uint32_t magic;
+    uint8_t  ver;
+    uint8_t  points;
+    uint8_t  runs[TC_POINTS];
+    float    sens[TC_POINTS];
+    float    rate[TC_POINTS];
+};
+static_assert(EE_ADDR_TCOMP + sizeof(TcBlob) <= EE_ADDR_CAL,
+              "temperature table overruns EEPROM area");
+
+/* ───────── module state ───────── */
+static float   gSens[TC_POINTS];
+static float   gRate[TC_POINTS];
+static uint8_t gRuns[TC_POINTS];
+static bool    gInit = false;
+
+static constexpr float INV_STEP = 1.0f / TC_STEP_C;
+
+static inline void ensure() { if (!gInit) reset(); }
+
+/* grid index and weight of the upper point; ends clamp */
+static inline uint8_t locate(float tC, float& f)
+{
+    float x = (tC - TC_T_MIN_C) * INV_STEP;
+    if (!(x > 0.0f))          { f = 0.0f; return 0; }            // also NaN
+    if (x >= TC_POINTS - 1)   { f = 1.0f; return TC_POINTS - 2; }
+    uint8_t i = static_cast<uint8_t>(x);
+    f = x - i;
+    return i;
+}
+
+static inline float lookup(const float* k, float tC)
+{
+    if (tC != tC) return 1.0f;                   // no temperature channel
+    ensure();
+    float   f;
+    uint8_t i = locate(tC, f);
+    return k[i] + (k[i + 1] - k[i]) * f;
+}
+
+static bool learn(float* k, float tC, float obs)
+{
+    if (tC != tC || !(obs > TC_GAIN_MIN && obs < TC_GAIN_MAX)) return false;
+    ensure();
+    float   f;
+    uint8_t i = locate(tC, f);
+    float   e = obs - (k[i] + (k[i + 1] - k[i]) * f);
+
+    /* normalised: the interpolated gain at tC moves TC_LEARN_RATE·e */
+    float   g = TC_LEARN_RATE * e / ((1.0f - f) * (1.0f - f) + f * f);
+    k[i]     = constrain(k[i]     + g * (1.0f - f), TC_GAIN_MIN, TC_GAIN_MAX);
+    k[i + 1] = constrain(k[i + 1] + g * f,          TC_GAIN_MIN, TC_GAIN_MAX);
+    if (f < 0.5f) { if (gRuns[i]     < 255) ++gRuns[i];     }
+    else          { if (gRuns[i + 1] < 255) ++gRuns[i + 1]; }
+    return true;
+}
+
+/* ───────── public ───────── */
+float sensorGain(float tC) { return lookup(gSens, tC); }
+float rateGain  (float tC) { return lookup(gRate, tC); }
+
+bool learnRate(float tC, float meas_uL, float step_uL)
+{
+    if (step_uL < TC_LEARN_MIN_UL) return false;
+    return learn(gRate, tC, meas_uL / step_uL);
+}
+
+bool learnSensor(float tC, float ref_uL, float meas_uL)
+{
+    if (meas_uL < TC_LEARN_MIN_UL) return false;
+    /* the reference judges the corrected reading: compound the gain */
+    return learn(gSens, tC, sensorGain(tC) * ref_uL / meas_uL);
+}
+
+void reset()
+{
+    for (uint8_t i = 0; i < TC_POINTS; ++i) { gSens[i] = gRate[i] = 1.0f; gRuns[i] = 0; }
+    gInit = true;
+}
+
+bool load()
+{
+    reset();
+    TcBlob blob{}; EEPROM.get(EE_ADDR_TCOMP, blob);
+    if (blob.magic != MAGIC || blob.ver != VERSION ||
+        blob.points != TC_POINTS) return false;
+
+    for (uint8_t i = 0; i < TC_POINTS; ++i) {
+        bool ok = blob.sens[i] >= TC_GAIN_MIN && blob.sens[i] <= TC_GAIN_MAX &&
+                  blob.rate[i] >= TC_GAIN_MIN && blob.rate[i] <= TC_GAIN_MAX;
+        if (!ok) { reset(); return false; }
+        gSens[i] = blob.sens[i]; gRate[i] = blob.rate[i]; gRuns[i] = blob.runs[i];
+    }
+    return true;
+}
+
+void save()
+{
+    ensure();
+    TcBlob blob{};
+    blob.magic = MAGIC; blob.ver = VERSION; blob.points = TC_POINTS;
+    for (uint8_t i = 0; i < TC_POINTS; ++i) {
+        blob.runs[i] = gRuns[i]; blob.sens[i] = gSens[i]; blob.rate[i] = gRate[i];
+    }
+    EEPROM.put(EE_ADDR_TCOMP, blob);
+    State::requestCommit();                    // written between ticks
+}
+
+float   pointC(uint8_t i)   { return TC_T_MIN_C + i * TC_STEP_C; }
+float   sensorAt(uint8_t i) { ensure(); return gSens[i < TC_POINTS ? i : 0]; }
+float   rateAt(uint8_t i)   { ensure(); return gRate[i < TC_POINTS ? i : 0]; }
+uint8_t runsAt(uint8_t i)   { return gRuns[i < TC_POINTS ? i : 0]; }
+
+}   // namespace TempComp
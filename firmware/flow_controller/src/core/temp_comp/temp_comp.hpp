@@ -0,0 +1,42 @@
+#pragma once
+/*  temp_comp.hpp – temperature-indexed flow correction
+ *  ----------------------------------------------------
+ *  Viscosity moves the sensor's calibration and tube compliance
+ *  moves the volume per step; both drift with the lab temperature.
+ *  Two gains are kept on a uniform grid (TC_T_MIN_C + i·TC_STEP_C):
+ *
+ *    sensorGain(T)  true / indicated flow   – multiply every sample
+ *    rateGain(T)    delivered / nominal     – divide the rate command
+ *
+ *  Lookup is one multiply, one truncation and one lerp: O(1) at the
+ *  full sample rate.  Below / above the grid the end points hold;
+ *  NaN (sensor without a temperature channel) gives 1.
+ *
+ *  learnRate()   – after a finished dose: measured / step volume
+ *  learnSensor() – from an external reference (weighed dose)
+ *  Each observation moves the two bracketing points, split by the
+ *  interpolation weight, so the gain at that temperature closes
+ *  TC_LEARN_RATE of its error.
+ */
+
+#include <stdint.h>
+
+namespace TempComp {
+
+float sensorGain(float tC);
+float rateGain  (float tC);
+
+bool  learnRate  (float tC, float meas_uL, float step_uL);
+bool  learnSensor(float tC, float ref_uL,  float meas_uL);
+
+void  reset();                      // all gains 1
+bool  load();                       // EEPROM (EE_ADDR_TCOMP)
+void  save();                       // stage; committed between ticks
+
+/* table access for reporting */
+float   pointC(uint8_t i);
+float   sensorAt(uint8_t i);
+float   rateAt(uint8_t i);
+uint8_t runsAt(uint8_t i);          // observations that touched point i
+
+}   // namespace TempComp
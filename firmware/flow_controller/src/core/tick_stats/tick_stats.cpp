@@ -0,0 +1,24 @@
+#include "tick_stats.hpp"
+
+void TickStats::record(uint32_t dt_us, float q_uL_min)
+{
+    /* bin = bit length of dt  (0 → bin 0, 1 → 1, 2‥3 → 2, …) */
+    uint8_t k = dt_us ? static_cast<uint8_t>(32 - __builtin_clz(dt_us)) : 0;
+    if (k >= BINS) k = BINS - 1;
+    ++_bins[k];
+
+    ++_n;
+    _sum += dt_us;
+    if (dt_us < _min) _min = dt_us;
+    if (dt_us > _max) _max = dt_us;
+
+    /* ΔV error of a fixed-period integrator:  Q/60e6 · (dt − nominal)  */
+    _dvErr += static_cast<double>(q_uL_min) *
+              (static_cast<double>(dt_us) - _nominal) / 60.0e6;
+}
+
+void TickStats::reset()
+{
+    for (auto& b : _bins) b = 0;
+    _n = 0; _min = UINT32_MAX; _max = 0; _sum = 0; _dvErr = 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+/*  tick_stats.hpp ─ control-tick interval statistics
+ *  -------------------------------------------------
+ *  • record()  — feed the measured tick-to-tick interval (µs)
+ *  • bins      — log2 histogram: bin k counts dt ∈ [2^(k-1), 2^k) µs
+ *  • dvErr     — Σ Q·(dt − dt_nominal): the volume an integrator using
+ *                the nominal period would have mis-counted (µL)
+ */
+
+#include <stdint.h>
+
+class TickStats {
+public:
+    static constexpr uint8_t BINS = 32;
+
+    explicit TickStats(uint32_t nominal_us) : _nominal(nominal_us) {}
+
+    void record(uint32_t dt_us, float flow_uL_per_min);
+    void reset();
+
+    uint32_t count()   const { return _n; }
+    uint32_t min_us()  const { return _n ? _min : 0; }
+    uint32_t max_us()  const { return _max; }
+    float    mean_us() const { return _n ? static_cast<float>(_sum / _n) : 0.0f; }
+    float    dvErr_uL() const { return static_cast<float>(_dvErr); }
+    uint32_t bin(uint8_t k) const { return k < BINS ? _bins[k] : 0; }
+
+private:
+    uint32_t _nominal;
+    uint32_t _bins[BINS]{};
+    uint32_t _n{0}, _min{UINT32_MAX}, _max{0};
+    uint64_t _sum{0};
+    double   _dvErr{0};
+};
@@ -0,0 +1,277 @@
+/*
+ *  totalizer.cpp — journaled volume / run-time totals
+ *  ---------------------------------------------------
+ *  tick() only stages; service() does the storage I/O, called by the
+ *  control loop right after a tick so a page program never lands
+ *  inside one.
+ */
+
+#include "totalizer.hpp"
+#include "../../include/_include.hpp"          // TOTAL_*, RAIL_*, EE_ADDR_TOTAL
+#include <EEPROM.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include "hardware/flash.h"
+#include "hardware/irq.h"
+#include "hardware/regs/addressmap.h"
+#include "hardware/regs/m0plus.h"
+extern uint8_t _FS_start;                      // arduino-pico linker symbols
+extern uint8_t _FS_end;
+#endif
+
+namespace Totalizer {
+
+/* ───────── record ───────── */
+struct Rec {
+    uint32_t seq;
+    uint32_t run_s;
+    uint32_t vol_uL;
+    uint16_t vol_nL;            // 0 … 999
+    uint16_t crc;
+};
+static_assert(sizeof(Rec) == 16, "journal record must stay 16 B");
+static_assert(EE_ADDR_TOTAL + TOTAL_EE_SLOTS * sizeof(Rec) <= EE_ADDR_TCOMP,
+              "totalizer ring overlaps temperature table");
+
+static uint16_t crc16(const uint8_t* p, uint8_t n)      // CCITT-FALSE
+{
+    uint16_t c = 0xFFFF;
+    while (n--) {
+        c ^= static_cast<uint16_t>(*p++) << 8;
+        for (uint8_t k = 0; k < 8; ++k) c = (c & 0x8000) ? (c << 1) ^ 0x1021 : c << 1;
+    }
+    return c;
+}
+static bool valid(const Rec& r)
+{
+    return r.seq != 0xFFFFFFFF && r.vol_nL < 1000 &&
+           r.crc == crc16(reinterpret_cast<const uint8_t*>(&r), offsetof(Rec, crc));
+}
+
+/* ───────── module state ───────── */
+static double   gTotal   = 0.0;     // µL
+static uint64_t gRunUs   = 0;
+static double   gSaved   = 0.0;     // total at the last staged record
+static uint32_t gLastMs  = 0;       // time of the last staged record
+static uint32_t gSeq     = 0;
+static uint32_t gWritten = 0;
+static bool     gRailDown = false;
+
+static Rec      gPending{};
+static bool     gHavePending = false;
+
+static uint16_t gNext     = 0;      // slot to write next
+static bool     gSpareOk  = false;  // sector after the current one erased
+
+/* ───────── storage back-ends ───────── */
+#if defined(ARDUINO_ARCH_RP2040)
+static constexpr uint16_t RPS   = FLASH_SECTOR_SIZE / sizeof(Rec);   // 256
+static constexpr uint16_t RPP   = FLASH_PAGE_SIZE   / sizeof(Rec);   // 16
+static bool               gFlash = false;
+static uint32_t           gBase  = 0;                 // flash offset
+
+static uint16_t slots() { return gFlash ? TOTAL_FLASH_SECTORS * RPS : TOTAL_EE_SLOTS; }
+
+static const Rec& flashRec(uint16_t i)
+{ return reinterpret_cast<const Rec*>(XIP_BASE + gBase)[i]; }
+
+static bool slotBlank(uint16_t i)
+{
+    auto* w = reinterpret_cast<const uint32_t*>(&flashRec(i));
+    return (w[0] & w[1] & w[2] & w[3]) == 0xFFFFFFFF;
+}
+
+static bool sectorBlank(uint8_t s)
+{
+    auto* w = reinterpret_cast<const uint32_t*>(XIP_BASE + gBase + s * FLASH_SECTOR_SIZE);
+    for (uint16_t i = 0; i < FLASH_SECTOR_SIZE / 4; ++i) if (w[i] != 0xFFFFFFFF) return false;
+    return true;
+}
+
+/* Flash is off the bus while it erases / programs, so every IRQ whose
+   handler runs from flash is masked – all but the step wrap, which is
+   RAM-resident (drv8825.cpp) and keeps the odometer counting through
+   a 45 ms sector erase.  The other core is not in use.              */
+static constexpr uint32_t KEEP_IRQS = 1u << PWM_IRQ_WRAP;
+
+static uint32_t flashBegin()
+{
+    uint32_t on = *reinterpret_cast<volatile uint32_t*>(PPB_BASE + M0PLUS_NVIC_ISER_OFFSET);
+    irq_set_mask_enabled(on & ~KEEP_IRQS, false);
+    return on & ~KEEP_IRQS;
+}
+static void flashEnd(uint32_t masked) { irq_set_mask_enabled(masked, true); }
+
+static void sectorErase(uint8_t s)
+{
+    uint32_t m = flashBegin();
+    flash_range_erase(gBase + s * FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
+    flashEnd(m);
+}
+#else
+static constexpr bool     gFlash = false;             // EEPROM only
+static constexpr uint16_t slots() { return TOTAL_EE_SLOTS; }
+#endif
+
+static Rec readSlot(uint16_t i)
+{
+#if defined(ARDUINO_ARCH_RP2040)
+    if (gFlash) return flashRec(i);
+#endif
+    Rec r{}; EEPROM.get(EE_ADDR_TOTAL + i * sizeof(Rec), r);
+    return r;
+}
+
+static void writeSlot(uint16_t i, const Rec& r)
+{
+#if defined(ARDUINO_ARCH_RP2040)
+    if (gFlash) {
+        if (i % RPS == 0 && !gSpareOk && !sectorBlank(i / RPS))
+            sectorErase(i / RPS);                      // forced: no gap since entering the last one
+        if (i % RPS == 0) gSpareOk = false;            // next sector now pending
+
+        /* NOR: 0xFF bytes leave the page's other records untouched */
+        static uint8_t page[FLASH_PAGE_SIZE];
+        memset(page, 0xFF, sizeof(page));
+        memcpy(page + (i % RPP) * sizeof(Rec), &r, sizeof(Rec));
+        uint32_t m = flashBegin();
+        flash_range_program(gBase + (i / RPP) * FLASH_PAGE_SIZE, page, FLASH_PAGE_SIZE);
+        flashEnd(m);
+        return;
+    }
+#endif
+    EEPROM.put(EE_ADDR_TOTAL + i * sizeof(Rec), r);
+#if defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
+    EEPROM.commit();
+#endif
+}
+
+/* ───────── staging ───────── */
+static void stage()
+{
+    Rec r{};
+    r.seq    = ++gSeq;
+    r.run_s  = static_cast<uint32_t>(gRunUs / 1'000'000ULL);
+    double v = gTotal < 0 ? 0 : gTotal;
+    r.vol_uL = static_cast<uint32_t>(v);
+    r.vol_nL = static_cast<uint16_t>((v - r.vol_uL) * 1000.0);
+    if (r.vol_nL > 999) r.vol_nL = 999;
+    r.crc    = crc16(reinterpret_cast<const uint8_t*>(&r), offsetof(Rec, crc));
+
+    gPending     = r;
+    gHavePending = true;
+    gSaved       = gTotal;
+    gLastMs      = millis();
+}
+
+static bool readRailDown()
+{
+    if constexpr (!RAIL_SENSE_ENABLE) return false;
+    constexpr float K = 3.3f / 1023.0f * (R_SENSE_TOP + R_SENSE_BOTTOM) / R_SENSE_BOTTOM;
+    float v = analogRead(PIN_DETECT_24V) * K;
+    if (gRailDown) return v < RAIL_OK_V;
+    return v < RAIL_DROP_V;
+}
+
+/* ───────── public ───────── */
+void begin()
+{
+#if defined(ARDUINO_ARCH_RP2040)
+    uint32_t fsLen = &_FS_end - &_FS_start;
+    gFlash = fsLen >= TOTAL_FLASH_SECTORS * FLASH_SECTOR_SIZE;
+    if (gFlash)
+        gBase = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&_FS_end) - XIP_BASE)
+              - TOTAL_FLASH_SECTORS * FLASH_SECTOR_SIZE;
+    else
+        Serial.println(F("[TOTAL] FS < 16 KB – journal in EEPROM, written when stopped"));
+#endif
+
+    /* newest valid record wins; a torn write fails its CRC */
+    bool     any = false;
+    uint16_t at  = 0;
+    Rec      best{};
+    for (uint16_t i = 0; i < slots(); ++i) {
+        Rec r = readSlot(i);
+        if (!valid(r) || (any && static_cast<int32_t>(r.seq - best.seq) <= 0)) continue;
+        best = r; at = i; any = true;
+    }
+
+    if (any) {
+        gSeq   = best.seq;
+        gTotal = best.vol_uL + best.vol_nL * 1e-3;
+        gRunUs = static_cast<uint64_t>(best.run_s) * 1'000'000ULL;
+        gNext  = (at + 1) % slots();
+    }
+#if defined(ARDUINO_ARCH_RP2040)
+    /* NOR can't re-program a torn slot: skip to a blank one (a sector
+       boundary erases on entry anyway)                             */
+    while (gFlash && gNext % RPS && !slotBlank(gNext))
+        gNext = (gNext + 1) % slots();
+#endif
+    gSaved   = gTotal;
+    gLastMs  = millis();
+    gSpareOk = false;
+}
+
+void tick(float dV_uL, uint32_t dt_us, bool running)
+{
+    if (dV_uL > 0) gTotal += dV_uL;                    // resets of the session
+    if (running)   gRunUs += dt_us;                    // tracker never subtract
+
+    bool down = readRailDown();
+    bool drop = down && !gRailDown;
+    gRailDown = down;
+
+    bool unsaved = gTotal != gSaved;
+    if (drop || gTotal - gSaved >= TOTAL_CKPT_UL ||
+        (unsaved && millis() - gLastMs >= TOTAL_CKPT_MS))
+        stage();
+}
+
+bool service(bool pumpIdle)
+{
+    /* EEPROM path: a commit rewrites the whole sector with interrupts
+       masked and would stall the step odometer – the record waits for
+       the pump to stop, unless the rail is going                     */
+    if (gHavePending && !gFlash && !pumpIdle && !gRailDown) return false;
+
+    if (gHavePending) {
+        gHavePending = false;
+        writeSlot(gNext, gPending);
+        gNext = (gNext + 1) % slots();
+        ++gWritten;
+        return true;                                   // one storage op per gap
+    }
+
+#if defined(ARDUINO_ARCH_RP2040)
+    /* erase ahead: the sector the ring enters next, in the first free
+       gap – the pump may be running, the odometer ISR is not masked  */
+    if (gFlash && !gSpareOk) {
+        uint8_t spare = ((gNext + RPS - 1) / RPS) % TOTAL_FLASH_SECTORS;
+        bool erase = !sectorBlank(spare);
+        if (erase) sectorErase(spare);
+        gSpareOk = true;
+        return erase;
+    }
+#else
+    (void)pumpIdle;
+#endif
+    return false;
+}
+
+void clear()
+{
+    gTotal = 0.0;
+    gRunUs = 0;
+    stage();
+}
+
+double   total_uL()    { return gTotal; }
+uint32_t runTime_s()   { return static_cast<uint32_t>(gRunUs / 1'000'000ULL); }
+uint32_t checkpoints() { return gWritten; }
+uint32_t sequence()    { return gSeq; }
+bool     railDown()    { return gRailDown; }
+
+}   // namespace Totalizer
@@ -0,0 +1,37 @@
+#pragma once
+/*  totalizer.hpp ─ dispensed volume and pump run time, across resets
+ *  -----------------------------------------------------------------
+ *  • begin()   — restore the newest valid checkpoint (boot)
+ *  • tick()    — once per control tick: accumulate, stage a checkpoint
+ *                when TOTAL_CKPT_UL / TOTAL_CKPT_MS is reached or the
+ *                24 V rail drops.  RAM only, never touches storage.
+ *  • service() — between ticks: write the staged record, pre-erase
+ *                the next journal sector;
+ *                at most one storage operation per call
+ *
+ *  Records are 16 B {seq, run_s, µL, nL, crc}; the journal is a ring
+ *  so every cell is written once per cycle.  On RP2040 a checkpoint
+ *  is one 256 B page program (< 1 ms); the 4 KB sector erase (≈ 45 ms,
+ *  once per 256 checkpoints) is done ahead in the next free gap.  Both
+ *  mask every IRQ but the RAM-resident step wrap, so the odometer
+ *  keeps counting; the control tick after an erase runs late.
+ *  Without a 16 KB FS the ring lives in EEPROM and is written only
+ *  while the pump is stopped (or the rail drops).
+ */
+
+#include <stdint.h>
+
+namespace Totalizer {
+
+void     begin();
+void     tick(float dV_uL, uint32_t dt_us, bool running);
+bool     service(bool pumpIdle);    // true if it touched storage
+void     clear();                   // zero both totals (checkpointed)
+
+double   total_uL();
+uint32_t runTime_s();
+uint32_t checkpoints();             // written since boot
+uint32_t sequence();                // of the newest record
+bool     railDown();
+
+}   // namespace Totalizer
@@ -2,14 +2,27 @@
 
 VolumeTracker::VolumeTracker(float ρ) : _density(ρ) {}
 
-void VolumeTracker::update(float q_uL_min, unsigned long dt_ms)
+void VolumeTracker::update(float q_uL_min, uint32_t dt_us)
 {
-    /* ΔV = (Q / 60 000) · Δt   [µL] */
+    /* ΔV = (Q / 60 000 000) · Δt   [µL] */
     _vol_uL += static_cast<double>(q_uL_min) *
-               static_cast<double>(dt_ms) / 60000.0;
+               static_cast<double>(dt_us) / 60.0e6;
 }
 
-void  VolumeTracker::reset()     { _vol_uL = 0.0; }
+void VolumeTracker::update(const Sample& s)
+{
+    if (s.q & SampleQ::AIR) { _open = false; return; }  // air is not volume
+    if (!s.good()) return;                              // bridged on next good
+
+    if (_open)
+        _vol_uL += 0.5 * (static_cast<double>(_lastQ) + s.value) *
+                   static_cast<double>(s.t_us - _lastT) / 60.0e6;
+    _lastQ = s.value;
+    _lastT = s.t_us;
+    _open  = true;
+}
+
+void  VolumeTracker::reset()     { _vol_uL = 0.0; _open = false; }
 float VolumeTracker::volume_uL() const { return static_cast<float>(_vol_uL); }
 float VolumeTracker::mass_g()    const { return static_cast<float>(_vol_uL) *
                                                  _density / 1000.0f; }
@@ -1,16 +1,22 @@
 #pragma once
 /*  volume_tracker.hpp ─ cumulative volume / mass integrator
  *  ---------------------------------------------------------
- *  • update()  — integrate flow (µL / min) over Δt (ms)
+ *  • update()  — integrate flow (µL / min) over Δt (µs), or
+ *                trapezoid between consecutive good Samples: gaps
+ *                flagged LINK are bridged, AIR intervals are dropped
  *  • reset()   — clear running totals
  *  • getters   — volume_uL(), mass_g()
  */
 
+#include <stdint.h>
+#include "../sample/sample.hpp"
+
 class VolumeTracker {
 public:
     explicit VolumeTracker(float density_g_per_mL = 1.0f);
 
-    void  update(float flow_uL_per_min, unsigned long dt_ms);
+    void  update(float flow_uL_per_min, uint32_t dt_us);
+    void  update(const Sample& s);
     void  reset();
 
     float volume_uL() const;
@@ -19,4 +25,9 @@ public:
 private:
     float  _density;        // g / mL
     double _vol_uL{};       // use double to avoid rollover
+
+    /* last good sample, start of the open trapezoid */
+    float    _lastQ{0};
+    uint64_t _lastT{0};
+    bool     _open{false};
 };
@@ -1,5 +1,4 @@
 #pragma once
 
 #include "exp_ctrl/_exp_ctrl.hpp"
-#include "open_ctrl/open_ctrl.hpp"
 #include "min_ctrl/min_ctrl.hpp"
\ No newline at end of file
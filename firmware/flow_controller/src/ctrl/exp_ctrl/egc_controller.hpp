@@ -12,12 +12,14 @@ namespace egc {
    • Gain-schedules Ki (and α) with ExpParams
    • Runs a PID
    • Drives the pump in steps-per-second (SPS)
+   Sensor / Pump: Hal::FlowSensor<> / Hal::Pump<> back-ends
    ───────────────────────────────────────────────────────────── */
+template <class Sensor, class Pump>
 class Controller {
 public:
     Controller(const EgcParams& p,
-               IFlowSensor&     s,
-               IPumpDriver&     d)
+               Sensor&          s,
+               Pump&            d)
         : P(p), sensor(s), driver(d),
           sched(p.gain), pid()
     {
@@ -31,7 +33,7 @@ public:
     float update(float set_uL_per_min)
     {
         /* 1. Sensor & error */
-        float raw   = sensor.read_uL_per_min();
+        float raw   = sensor.read().value;      // held value on a bad sample
         float flow  = P.scale.a * raw + P.scale.b;
         float err   = set_uL_per_min - flow;
 
@@ -39,10 +41,10 @@ public:
         float e_dyn, Ki, alpha_dyn;
         sched.update(err, e_dyn, Ki, alpha_dyn);
 
-        /* 3. Δt for PID */
-        unsigned long now = millis();
-        float dt = (now - last_ms) * 1e-3f;   // ms → s
-        last_ms  = now;
+        /* 3. Δt for PID (µs; unsigned difference is wrap-safe) */
+        unsigned long now = micros();
+        float dt = (now - last_us) * 1e-6f;   // µs → s
+        last_us  = now;
 
         /* 4. PID output ∈ [0,1] */
         float u_frac = pid.update(err, e_dyn, Ki, dt);
@@ -50,7 +52,7 @@ public:
 
         /* 5. Scale to SPS & drive pump */
         float sps = u_frac * P.sps_max;
-        driver.setTargetSPS(sps);
+        driver.setSps(sps);
         return sps;
     }
 
@@ -58,16 +60,16 @@ public:
     {
         sched.reset();
         pid.reset();
-        last_ms = millis();
+        last_us = micros();
     }
 
 private:
     const EgcParams&  P;
-    IFlowSensor&      sensor;
-    IPumpDriver&      driver;
+    Sensor&           sensor;
+    Pump&             driver;
     GainScheduler     sched;
     PID               pid;
-    unsigned long     last_ms{millis()};
+    unsigned long     last_us{micros()};
 };
 
 } // namespace egc
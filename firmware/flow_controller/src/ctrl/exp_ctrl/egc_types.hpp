@@ -1,31 +1,10 @@
 #pragma once
 #include <stdint.h>
-#include <vector>
 
 namespace egc {
 
-/* ─── Hardware abstraction ──────────────────────────────── */
-struct IFlowSensor {
-    virtual float read_uL_per_min() = 0;
-};
-
-/* Pump interface now speaks SPS (steps-per-second) */
-struct IPumpDriver {
-    /* Primary API: absolute speed in SPS */
-    virtual void  setTargetSPS(float sps) = 0;
-
-    /* Convenience helpers */
-    virtual void  stop()                  { setTargetSPS(0.0f); }
-
-    /* ── Legacy wrapper (kept for older modules) ──────────
-       Interprets the argument as a 0-to-1 fraction of the
-       driver’s own MAX_SPS. Override in a concrete driver
-       if you need different scaling, or remove once all
-       callers are migrated.                                 */
-    virtual void  setCommand(float dutyFrac) { setTargetSPS(dutyFrac); }
-
-    virtual ~IPumpDriver() = default;
-};
+/* Hardware comes in as template parameters: any Hal::FlowSensor<>
+   and Hal::Pump<> back-end (devices/hal/hal.hpp).                  */
 
 /* ─── Raw-to-true scale (e.g. ADC) ───────────────────────── */
 struct ScaleAffine { float a = 1.0f, b = 0.0f; };
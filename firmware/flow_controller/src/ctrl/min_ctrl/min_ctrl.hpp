@@ -1,9 +1,74 @@
 #pragma once
-/*  min_ctrl.hpp – ultra-minimal control loop
-    (only buttons + OLED page toggle for now)        */
+/*  min_ctrl.hpp – PID flow-control loop, templated on the build
+    configuration (see build_config.hpp)                       */
 
 #include <Arduino.h>
 
+#include "../../include/_include.hpp"
+#include "../../core/_core.hpp"
+#include "../../build_config.hpp"
+
+/* 100 Hz scheduler (64-bit µs timebase) */
+constexpr uint32_t LOOP_DT_US = LOOP_INTERVAL_MS * 1000UL;
+
+template <class Cfg>
+class MinCtrl {
+    static_assert(Hal::isFlowSensor<typename Cfg::Sensor>,
+                  "Cfg::Sensor must derive from Hal::FlowSensor<>");
+    static_assert(Hal::isPump<typename Cfg::Pump>,
+                  "Cfg::Pump must derive from Hal::Pump<>");
+
+public:
+    MinCtrl();
+
+    void setup();                   // hardware + persisted state
+    bool loop();                    // runs step() when the tick is due
+    void step(uint64_t nowUs);      // one control tick
+
+    TickStats&            ticks()  { return mTicks; }
+    TickStats&            exec()   { return mExec; }    // step() run time
+    FlowKalman&           kalman() { return mKf; }
+    typename Cfg::Sensor& sensor() { return mSensor; }  // e.g. ReplaySensor::attach
+
+private:
+    void retuneNotch(double sps);   // roller pass of the running rate
+
+    typename Cfg::Display mDisplay;
+    typename Cfg::Input   mInput;
+    typename Cfg::Sensor  mSensor;
+    typename Cfg::Pump    mPump;
+
+    VolumeTracker mVolume {FLUID_DENSITY_G_ML};
+    BubbleGuard   mBubble {BUBBLE_RELEASE_MS};
+    TickStats     mTicks  {LOOP_DT_US};
+    TickStats     mExec   {LOOP_DT_US};             // record(run µs, 0)
+    SampleStats   mQuality{SAMPLE_WINDOW_TICKS};
+    OcclusionDetector mOccl;
+
+    Notch    mNotch[NOTCH_HARMONICS];               // roller pass + harmonics
+    BiQuad   mLpf0, mLpf1;                          // 2-section LPF
+    double   mRollSps = 0;                          // base rate the notches track
+    FlowKalman mKf;                                 // steps ⊕ sensor
+    double   mMeasuredRate = 0, mPidOutput = 0, mTargetRate = 0;
+    FlowPid  mPid;
+    bool     mWasEnabled = false;                   // pump-enable edge
+
+    uint64_t mLastLoopUs = 0, mPrevTickUs = 0;
+    uint32_t mLastFlush  = 0;
+    uint32_t mLastOdo    = 0;                       // odometer at last tick
+    float    mLastVol    = 0;                       // volume at last tick
+};
+
 /* top-level entry points called from the .ino wrapper */
 void ctrlSetup();
 void ctrlLoop();
+
+/* tick-interval histogram of the running loop ("J") */
+TickStats& ctrlTickStats();
+
+/* step / sensor fusion of the running loop ("F") */
+FlowKalman& ctrlKalman();
+
+/* cost report, printed between ticks ("B"): step() run time of the
+   live loop since the last report, and its RAM                    */
+bool ctrlRequestBench();
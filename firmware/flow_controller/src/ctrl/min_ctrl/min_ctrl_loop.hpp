@@ -0,0 +1,330 @@
+#pragma once
+/*  min_ctrl_loop.hpp — MinCtrl<Cfg> member definitions
+ *  ---------------------------------------------------
+ *  Included by min_ctrl.cpp, which instantiates the one configuration
+ *  the firmware runs (Build::Active), and by tools/sim/sim_configs.cpp,
+ *  which builds and times the plant-model configurations on the host.
+ *  All flow quantities are expressed in µL / min.
+ */
+
+#include "min_ctrl.hpp"
+#include "../../min_main.hpp"
+#include <Wire.h>
+
+extern volatile SystemState g_state;
+
+/* flow filter runs once per tick */
+constexpr float FS_HZ = 1000.0f / LOOP_INTERVAL_MS;
+
+/* ───── µL/min → step rate (1/32-step pulses / s, the odometer unit) ───── */
+static inline double rateToSps(double uLmin)
+{
+    double rpm = uLmin / static_cast<double>(VPR);
+    return (rpm / 60.0) * PULSES_PER_REV;
+}
+static inline double spsToRate(double sps) { return sps / rateToSps(1.0); }
+
+/* ─── MinCtrl<Cfg> ─── */
+template <class Cfg>
+MinCtrl<Cfg>::MinCtrl()
+    : mLpf0(BiQuad::lowpass(FLOW_LPF_HZ, FS_HZ, 1.30656f)),   // Butterworth Q pair
+      mLpf1(BiQuad::lowpass(FLOW_LPF_HZ, FS_HZ, 0.54120f)),
+      mPid({FLOW_PID_KP, FLOW_PID_KI, FLOW_PID_KD},
+           FLOW_PID_OUT_MIN, FLOW_PID_OUT_MAX,     // low clamp 50, not 0
+           PID_REF_TAU_S, PID_TRACK_S)
+{}
+
+template <class Cfg>
+void MinCtrl<Cfg>::setup()
+{
+    State::loadPersistent();
+    State::setPumpEnabled(false);
+    Program::load();
+    Totalizer::begin();
+    TempComp::load();
+    CalCurve::load();
+
+    Serial.begin(115200);
+    while (!Serial && millis() < 2000) {/* wait for USB */}
+
+    Wire.begin(); Wire.setClock(400'000);
+    mInput.begin(); mDisplay.begin();
+
+    if (!mSensor.begin())
+        Serial.println(F("[MIN_CTRL] Flow sensor init FAILED"));
+
+    mPump.begin();                      mPump.setTop(0);
+    mLastOdo = mPump.stepCount();
+
+    if (g_state.setpoint == 0)          State::setSetpoint(500.0f);
+    mTargetRate = g_state.setpoint;
+
+    if constexpr (Cfg::TELEMETRY) SerialRpt::subscribeAll(TELEM_DEFAULT_EVERY);
+    mLastLoopUs = mPrevTickUs = State::nowUs();
+}
+
+/* notch bank on the roller pass of the running rate and its
+   harmonics; constant Q, one cos() per tick (notch.hpp)        */
+template <class Cfg>
+void MinCtrl<Cfg>::retuneNotch(double sps)
+{
+    float fr = static_cast<float>(sps) * ROLLERS / RIPPLE_STEPS_PER_REV;
+    tuneHarmonics(mNotch, NOTCH_HARMONICS, fr, FS_HZ, NOTCH_Q, NOTCH_MIN_HZ, NOTCH_MAX_HZ);
+}
+
+template <class Cfg>
+bool MinCtrl<Cfg>::loop()
+{
+    uint64_t nowUs = State::nowUs();
+    if (nowUs - mLastLoopUs < LOOP_DT_US) return false;
+    mLastLoopUs += LOOP_DT_US;
+    step(nowUs);
+    mExec.record(static_cast<uint32_t>(State::nowUs() - nowUs), 0.0f);
+    return true;
+}
+
+template <class Cfg>
+void MinCtrl<Cfg>::step(uint64_t nowUs)
+{
+    /* measured (not nominal) interval drives every integrator */
+    uint32_t dtUs = static_cast<uint32_t>(nowUs - mPrevTickUs);
+    mPrevTickUs = nowUs;
+    g_state.currentTimeUs = nowUs;
+    g_state.currentTimeMs = static_cast<uint32_t>(nowUs / 1000);
+    g_state.tickDtUs      = dtUs;
+    uint32_t now = g_state.currentTimeMs;
+
+    /* ---------- UI ---------- */
+    mInput.poll();
+    if (mInput.pageChanged()) mDisplay.advancePage();
+    if constexpr (Cfg::SERIAL_CMD) SerialCmd::poll(Serial);
+
+    /* ---------- sensor ---------- */
+    Sample raw = mSensor.read();
+    float  tC  = mSensor.tempC();               // NaN → gains of 1
+    float  kS  = TempComp::sensorGain(tC);
+    float  kR  = TempComp::rateGain(tC);
+    Sample ind = raw;                           // uncorrected, for GravCal
+    raw.value  = CalCurve::correct(raw.value) * kS;
+    State::setRawFlow(raw.value);
+    g_state.tempC  = tC;
+    g_state.tcSens = kS;
+    g_state.tcRate = kR;
+    bool linkDown = raw.q & SampleQ::LINK;      // held value, no fresh reading
+    mQuality.record(raw);
+
+    const Hal::SensorHealth& h = mSensor.health();
+    g_state.sensOk       = raw.good();
+    g_state.sensGoodPct  = mQuality.goodFrac() * 100.0f;
+    g_state.sensState    = static_cast<uint8_t>(h.state);
+    g_state.sensErrs     = h.readErrors;
+    g_state.sensStale    = h.staleEvents;
+    g_state.sensClears   = h.busClears;
+    g_state.sensRestarts = h.restarts;
+
+    /* ---------- air-in-line guard ---------- */
+    bool bubble = mBubble.update(raw.q & SampleQ::AIR, now) && BUBBLE_HOLD_ENABLE;
+    g_state.bubble        = mBubble.active();
+    g_state.bubbleCount   = mBubble.events();
+    g_state.bubbleLastMs  = mBubble.lastStartMs();
+    g_state.bubbleTotalMs = mBubble.totalMs();
+
+    /* ---------- notch + LPF / fusion: hold policy – bad input never enters ---------- */
+    retuneNotch(mRollSps);                      // rate behind this sample
+    /* steps → µL/min through this temperature's rate gain: the fusion
+       learns only what TempComp does not already explain            */
+    float    uStep = g_state.spsCmd * UL_PER_STEP * 60.0f * kR;
+    uint64_t kfT0  = State::nowUs();
+    Sample filt = raw;
+    if (bubble) filt.q |= SampleQ::AIR;         // guard outlasts the flag
+    if (filt.good()) {
+        float x = raw.value;
+        for (Notch& n : mNotch) x = n(x);
+        float lp = mLpf1(mLpf0(x));
+        mKf.update(uStep, x, dtUs);
+        mMeasuredRate = KF_FEEDBACK ? mKf.flow() : lp;
+    } else {
+        mKf.predict(uStep, dtUs);               // steps alone carry it
+        filt.q |= SampleQ::HELD;
+    }
+    uint32_t kfUs = static_cast<uint32_t>(State::nowUs() - kfT0);
+    g_state.kfFlow = mKf.flow();
+    g_state.kfVpr  = mKf.vpr() * kR;            // total µL/rev
+    g_state.kfUs   = kfUs;
+    if (kfUs > g_state.kfUsMax) g_state.kfUsMax = kfUs;
+    filt.value = mMeasuredRate;
+    State::setFiltFlow(mMeasuredRate);
+
+    /* ---------- totals: link gaps bridged, air dropped ---------- */
+    mVolume.update(filt);
+    mTicks.record(dtUs, mMeasuredRate);
+    g_state.volume_uL = mVolume.volume_uL();
+    g_state.mass_g    = mVolume.mass_g();
+
+    /* lifetime totals: staged here, written by ctrlLoop between ticks */
+    Totalizer::tick(g_state.volume_uL - mLastVol, dtUs, g_state.pumpEnabled);
+    mLastVol = g_state.volume_uL;
+    g_state.total_uL  = Totalizer::total_uL();
+    g_state.runTime_s = Totalizer::runTime_s();
+
+    /* ---------- set-point program (paused while pump is off) ---------- */
+    if (Program::active() && g_state.pumpEnabled) {
+        Program::tick(g_state.volume_uL);
+        if (Program::state() == Program::Run::DONE)     // end action: hold it
+            State::setSetpoint(Program::setpoint());
+    }
+    g_state.progState = static_cast<uint8_t>(Program::state());
+    g_state.progStep  = Program::activeStep();
+    g_state.progSp    = Program::active() ? Program::setpoint() : g_state.setpoint;
+
+    /* ---------- exact-volume dose ---------- */
+    uint32_t odo = mPump.stepCount();
+    switch (Dose::tick(odo, g_state.volume_uL, mPump.stopReached(),
+                       g_state.pumpEnabled, now)) {
+        case Dose::Event::STARTED:
+            mPump.stopAt(Dose::stopCount());
+            State::setPumpEnabled(true);
+            break;
+        case Dose::Event::STOPPED:              // driver already halted
+            State::setPumpEnabled(false);
+            mPump.clearStop();
+            break;
+        case Dose::Event::FINISHED:
+            /* a finished dose is a delivery calibration at this temperature */
+            if (TempComp::learnRate(tC, Dose::stats().meas_uL, Dose::stats().step_uL))
+                TempComp::save();               // pump is stopped
+            if constexpr (Cfg::TELEMETRY) SerialRpt::emitDoseJSON(Dose::stats());
+            break;
+        case Dose::Event::ABORTED:
+            State::setPumpEnabled(false);
+            mPump.clearStop();
+            break;
+        default: break;
+    }
+    g_state.dosePhase = static_cast<uint8_t>(Dose::phase());
+    g_state.doseRem_uL = Dose::remaining_uL(odo);
+
+    /* ---------- gravimetric calibration (balance on UART1) ---------- */
+    if (GravCal::active()) {
+        Balance::poll(now);
+        Balance::Reading br;
+        if (Balance::pop(br)) GravCal::weigh(br.g, br.t_ms);
+    }
+    switch (GravCal::tick(ind, kS, g_state.pumpEnabled, now)) {
+        case GravCal::Event::STARTED:
+            Balance::begin();
+            State::setPumpEnabled(true);
+            break;
+        case GravCal::Event::POINT:
+            if constexpr (Cfg::TELEMETRY) SerialRpt::emitGravPointJSON(GravCal::last());
+            break;
+        case GravCal::Event::FINISHED:
+        case GravCal::Event::FAILED:
+            Balance::end();
+            State::setPumpEnabled(false);
+            if constexpr (Cfg::TELEMETRY) SerialRpt::emitGravJSON();
+            break;
+        default: break;
+    }
+    g_state.gcalPhase = static_cast<uint8_t>(GravCal::phase());
+
+    /* ---------- delivery monitor: steps vs. measured ---------- */
+    if (mOccl.update(g_state.spsCmd, odo - mLastOdo, raw, dtUs)) {   // last tick's command
+        using OS = OcclusionDetector::State;
+        OS os = mOccl.state();
+        if (OCCL_STOP_PUMP && (os == OS::OCCLUDED || os == OS::STALLED)) {
+            if (Dose::active()) Dose::abort();
+            State::setPumpEnabled(false);
+        }
+        if constexpr (Cfg::TELEMETRY) SerialRpt::emitOcclJSON(mOccl);
+    }
+    mLastOdo = odo;
+    g_state.occlState = static_cast<uint8_t>(mOccl.state());
+    g_state.occlRatio = mOccl.ratio();
+
+    /* ---------- roller ripple: learn g(angle) from the unfiltered flow ---------- */
+    if (g_state.pumpEnabled) Ripple::observe(odo, raw.value, filt.good());
+    g_state.ripple   = Ripple::active();
+    g_state.ripplePP = Ripple::peakToPeak() * 100.0f;
+
+    /* ---------- control ---------- */
+    mTargetRate = GravCal::active() ? GravCal::setpoint() : g_state.progSp;
+
+    /* braking ceiling applies to the set-point and to the command */
+    double cap = (Dose::phase() == Dose::Phase::RUNNING)
+                 ? Dose::rateCap(odo) : 1e9;
+    if (mTargetRate > cap) mTargetRate = cap;
+
+    if (g_state.pumpEnabled) {
+        float dt = dtUs * 1e-6f;
+        if (!mWasEnabled) mPid.start(mMeasuredRate);    // bumpless enable
+
+        /* feed-forward: the set-point through the residual delivery
+           gain the fusion has learned (kR is undone below), so the
+           PID only trims what neither explains                     */
+        float ff = static_cast<float>(mTargetRate) / mKf.gain();
+
+        /* A bad sample holds mPidOutput; the next good one re-seeds
+           the integrator from it, so the resume is bumpless.  With
+           the link down the held command stands, or the set-point
+           is run open-loop through the feed-forward. */
+        if (filt.good()) {
+            mPidOutput = mPid.compute(mTargetRate, mMeasuredRate, ff, dt);
+        } else {
+            if (linkDown && SENS_FALLBACK_FEEDFORWARD) mPidOutput = ff;
+            mPid.hold(mPidOutput);
+        }
+
+        /* µL/min → nominal steps: undo this temperature's delivery gain;
+           the pump picks its µ-step mode and period from the rate      */
+        double   sps = rateToSps((mPidOutput < cap ? mPidOutput : cap) / kR);
+        uint16_t top = Hal::spsToTop(sps);      // 1/32-step equivalent
+        mRollSps = sps;
+        double spsMod = Ripple::command(odo, sps);    // ÷ g(angle) when enabled
+        float spsCmd = mPump.setSps(spsMod);    // what the pump really runs
+
+        /* anti-windup against the rate actually delivered: brake cap,
+           step-rate ceiling and period quantisation all count      */
+        double achieved = spsMod > 0 ? spsCmd * (sps / spsMod) : 0.0;
+        mPid.track(static_cast<float>(spsToRate(achieved) * kR), dt);
+        State::setTop(top);                     // NEW → JSON shows "top"
+        g_state.ustep = mPump.microstep();
+
+        float rpmCmd = spsCmd * 60.0f / PULSES_PER_REV;
+
+        g_state.spsCmd    = spsCmd;
+        g_state.spsErrPpm = spsMod > 0 ? static_cast<float>((spsCmd - spsMod) / spsMod * 1e6) : 0.0f;
+        g_state.rpmCmd    = rpmCmd;
+    } else {
+        mPump.setTop(0);
+        mRollSps = 0;
+        Ripple::idle();
+        State::setTop(0);
+        g_state.spsCmd = 0; g_state.spsErrPpm = 0; g_state.rpmCmd = 0;
+    }
+    mWasEnabled = g_state.pumpEnabled;
+
+    /* ---------- status LED: faults overlay the pump colour ---------- */
+    bool fault = h.state == Hal::SensorState::FAILED ||
+                 mOccl.state() != OcclusionDetector::State::OK;
+    bool warn  = linkDown || g_state.bubble;
+    if (fault) RGB::overlay(RGB::Prio::FAULT, RGB::blink(LED_RED, LED_OFF, 250));
+    else       RGB::clear  (RGB::Prio::FAULT);
+    if (warn)  RGB::overlay(RGB::Prio::WARN,  RGB::fade(LED_AMBER, LED_OFF, 1000));
+    else       RGB::clear  (RGB::Prio::WARN);
+    RGB::tick(now);
+
+    /* ---------- telemetry ---------- */
+    g_state.pidOut = mPidOutput;
+    g_state.pidP   = mPid.pTerm();
+    g_state.pidI   = mPid.iTerm();
+    if constexpr (Cfg::TELEMETRY) SerialRpt::tick(g_state);
+
+    /* ---------- persistence: staged, committed by ctrlLoop ---------- */
+    if (now - mLastFlush >= 5000) {
+        mLastFlush = now;
+        State::stagePersistent();
+    }
+
+    mDisplay.show(State::read());
+}
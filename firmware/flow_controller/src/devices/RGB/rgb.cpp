@@ -5,6 +5,19 @@ namespace {
 Adafruit_NeoPixel strip(RGB_NUM_PIXELS, PIN_RGB_DATA,
                         NEO_GRB + NEO_KHZ800);
 
+constexpr uint8_t QUEUE_LEN = 4;
+
+struct Layer { RGB::Pattern pat; uint32_t t0; bool on, start; };
+
+bool         inited = false;
+LEDColour    base   = LED_OFF;
+Layer        over[static_cast<uint8_t>(RGB::Prio::N)];
+RGB::Pattern queue[QUEUE_LEN];
+uint8_t      qHead = 0, qLen = 0;
+uint32_t     qT0   = 0;
+bool         qStart = false;                 // head not yet timed
+uint32_t     shown  = 0;                     // last colour sent
+
 /* map enum → solid colour */
 uint32_t mapColour(LEDColour c)
 {
@@ -16,6 +29,39 @@ uint32_t mapColour(LEDColour c)
         default:         return 0;                       // OFF
     }
 }
+
+/* per-channel a + (b − a)·x/255, gamma-corrected for a visually even fade */
+uint32_t lerp(uint32_t a, uint32_t b, uint8_t x)
+{
+    uint32_t out = 0;
+    for (uint8_t sh = 0; sh < 24; sh += 8) {
+        int32_t ca = (a >> sh) & 0xFF, cb = (b >> sh) & 0xFF;
+        out |= static_cast<uint32_t>(ca + (cb - ca) * x / 255) << sh;
+    }
+    return Adafruit_NeoPixel::gamma32(out);
+}
+
+uint32_t render(const RGB::Pattern& p, uint32_t t)
+{
+    uint32_t ph = t % p.period_ms;
+    switch (p.kind) {
+        case RGB::Kind::BLINK:
+            return mapColour(ph < p.period_ms / 2 ? p.a : p.b);
+        case RGB::Kind::FADE: {                          // triangle a → b → a
+            uint32_t half = p.period_ms / 2 ? p.period_ms / 2 : 1;
+            uint32_t x    = ph < half ? ph : p.period_ms - ph;   // ≤ half
+            return lerp(mapColour(p.a), mapColour(p.b), x * 255 / half);
+        }
+        default:
+            return mapColour(p.a);
+    }
+}
+
+bool finished(const RGB::Pattern& p, uint32_t t, uint8_t minCycles)
+{
+    uint8_t n = p.cycles ? p.cycles : minCycles;
+    return n && t >= static_cast<uint32_t>(n) * p.period_ms;
+}
 } // namespace
 
 /* ------------------------------------------------------------------ */
@@ -28,11 +74,59 @@ void RGB::begin()
     strip.begin();
     strip.setBrightness(30);   // adjust 0-255 as needed
     strip.show();              // start OFF
+    shown  = 0;
+    inited = true;
 }
 
 /* ------------------------------------------------------------------ */
-void RGB::setColour(LEDColour c)
+void RGB::setColour(LEDColour c) { base = c; }
+
+bool RGB::play(const Pattern& p)
 {
-    strip.setPixelColor(0, mapColour(c));
+    if (qLen >= QUEUE_LEN || !p.period_ms) return false;
+    queue[(qHead + qLen++) % QUEUE_LEN] = p;
+    if (qLen == 1) qStart = true;
+    return true;
+}
+
+void RGB::overlay(Prio p, const Pattern& pat)
+{
+    Layer& l = over[static_cast<uint8_t>(p)];
+    if (l.on && l.pat == pat) return;        // keep phase
+    l = {pat, 0, pat.period_ms != 0, true};   // timed from the next tick
+}
+
+void RGB::clear(Prio p) { over[static_cast<uint8_t>(p)].on = false; }
+
+/* ------------------------------------------------------------------ */
+void RGB::tick(uint32_t now)
+{
+    if (!inited) return;
+
+    /* queue: retire finished heads, time the new one from now */
+    while (qLen) {
+        if (qStart) { qT0 = now; qStart = false; }
+        if (!finished(queue[qHead], now - qT0, 1)) break;
+        qHead = (qHead + 1) % QUEUE_LEN;
+        qStart = --qLen > 0;
+    }
+
+    uint32_t c = mapColour(base);
+    if (qLen) c = render(queue[qHead], now - qT0);
+
+    for (int8_t i = static_cast<int8_t>(Prio::N) - 1; i >= 0; --i) {
+        Layer& l = over[i];
+        if (!l.on) continue;
+        if (l.start) { l.t0 = now; l.start = false; }
+        if (finished(l.pat, now - l.t0, 0)) { l.on = false; continue; }
+        c = render(l.pat, now - l.t0);
+        break;
+    }
+
+    /* single pixel: one PIO FIFO word, and ≥10 ms since the last
+       frame always satisfies the latch time, so show() never waits */
+    if (c == shown) return;
+    strip.setPixelColor(0, c);
     strip.show();
+    shown = c;
 }
@@ -1,6 +1,13 @@
 #pragma once
-/* rgb.hpp – tiny wrapper for the on-board WS2812 (XIAO RP2040)
+/* rgb.hpp – tick-driven animator for the on-board WS2812 (XIAO RP2040)
    Requires:  Adafruit_NeoPixel library
+
+   Three layers, highest wins:
+     overlays  – per-priority patterns (faults, warnings) until cleared
+     queue     – finite one-shot patterns (confirmation flashes), FIFO
+     base      – solid status colour from setColour()
+   tick() renders the winner and pushes a frame only when the colour
+   changed; nothing here ever waits.
    ─────────────────────────────────────────────────────────── */
 
 #include <Arduino.h>
@@ -9,10 +16,41 @@
 
 namespace RGB {
 
+enum class Kind : uint8_t { SOLID, BLINK, FADE };
+enum class Prio : uint8_t { WARN, FAULT, N };   // higher value wins
+
+struct Pattern {
+    Kind      kind;
+    LEDColour a, b;             // BLINK: on / off half;  FADE: end points
+    uint16_t  period_ms;        // one blink or one a → b → a sweep
+    uint8_t   cycles;           // 0 = until replaced (overlays only)
+
+    bool operator==(const Pattern& o) const
+    { return kind == o.kind && a == o.a && b == o.b &&
+             period_ms == o.period_ms && cycles == o.cycles; }
+};
+
+constexpr Pattern solid(LEDColour c)
+{ return {Kind::SOLID, c, c, 1, 0}; }
+constexpr Pattern blink(LEDColour a, LEDColour b, uint16_t period_ms, uint8_t cycles = 0)
+{ return {Kind::BLINK, a, b, period_ms, cycles}; }
+constexpr Pattern fade(LEDColour a, LEDColour b, uint16_t period_ms, uint8_t cycles = 0)
+{ return {Kind::FADE, a, b, period_ms, cycles}; }
+
 /* call once in setup() ------------------------------------------------ */
 void begin();
 
-/* set solid colour instantly ----------------------------------------- */
+/* base layer: solid status colour ------------------------------------- */
 void setColour(LEDColour c);
 
+/* queue a one-shot pattern (cycles 0 plays once); false if full ------- */
+bool play(const Pattern& p);
+
+/* overlay at priority p; re-setting the same pattern keeps its phase -- */
+void overlay(Prio p, const Pattern& pat);
+void clear(Prio p);
+
+/* once per control tick: render and push the frame if it changed ------ */
+void tick(uint32_t nowMs);
+
 }   // namespace RGB
@@ -5,11 +5,15 @@
 
 // ─────────────────────────────────────────────────────────
 // Central device aggregator header for all hardware modules
-// Includes displays, flow sensors, pump drivers, and inputs
+// Includes displays, flow sensors, pump drivers, and inputs,
+// the HAL they implement and the simulated plant
 // ─────────────────────────────────────────────────────────
 
+#include "hal/hal.hpp"
 #include "displays/_displays.hpp"
 #include "flow_sensors/_flow_sensors.hpp"
 #include "pump_drivers/_pump_drivers.hpp"   
 #include "user_inputs/_user_inputs.hpp" 
-#include "RGB/rgb.hpp"    
+#include "RGB/rgb.hpp"
+#include "balance/balance.hpp"
+#include "sim/sim.hpp"    
@@ -0,0 +1,121 @@
+/*  balance.cpp – MT-SICS "SI" poller and line parser
+ */
+
+#include "balance.hpp"
+#include "../../include/_include.hpp"          // PIN_BAL_*, BAL_*
+#include <stdlib.h>
+
+namespace Balance {
+
+/* ───────── module state ───────── */
+#if defined(ARDUINO_ARCH_RP2040) && defined(BAL_UART_PINS)
+#define BAL_UART 1
+static HardwareSerial& gPort = Serial2;         // UART1
+#elif !defined(ARDUINO_ARCH_RP2040)
+#define BAL_UART 1
+static HardwareSerial& gPort = Serial1;
+#else
+#define BAL_UART 0                              // XIAO: relayed over USB
+#endif
+
+static char     gLine[32];
+static uint8_t  gLen     = 0;
+static bool     gOpen    = false;
+static bool     gWaiting = false;   // request out, no reply yet
+static uint32_t gSentMs  = 0;
+static uint16_t gErrors  = 0;
+
+static Reading  gReading{};
+static bool     gFresh   = false;
+
+/* "S S      12.3456 g" → reading; anything else is an error */
+static bool parse(const char* l, Reading& r)
+{
+    if (l[0] != 'S' || l[1] != ' ') return false;
+    if (l[2] != 'S' && l[2] != 'D') return false;
+
+    char* end;
+    r.g = strtof(l + 3, &end);
+    if (end == l + 3) return false;
+    while (*end == ' ') ++end;
+    if (end[0] != 'g' || end[1] != '\0') return false;   // grams only
+    r.stable = l[2] == 'S';
+    return true;
+}
+
+/* ───────── public ───────── */
+void begin()
+{
+#if BAL_UART
+#if defined(ARDUINO_ARCH_RP2040)
+    gPort.setTX(PIN_BAL_TX);
+    gPort.setRX(PIN_BAL_RX);
+#endif
+    gPort.begin(BAL_BAUD);
+#endif
+    gLen = 0; gWaiting = false; gFresh = false; gErrors = 0;
+    gOpen = true;
+}
+
+void end()
+{
+#if BAL_UART
+    if (gOpen) gPort.end();
+#endif
+    gOpen = false;
+}
+
+void poll(uint32_t now)
+{
+#if BAL_UART
+    if (!gOpen) return;
+
+    while (gPort.available()) {
+        char c = gPort.read();
+        if (c == '\r') continue;
+        if (c != '\n') {
+            if (gLen < sizeof(gLine) - 1) gLine[gLen++] = c;
+            continue;
+        }
+        gLine[gLen] = '\0';
+        gLen = 0;
+        if (!gWaiting) continue;                    // stray / late line
+        gWaiting = false;
+
+        Reading r;
+        if (!parse(gLine, r)) { ++gErrors; continue; }
+        r.t_ms   = gSentMs;
+        gReading = r;
+        gFresh   = true;
+    }
+
+    if (gWaiting && now - gSentMs >= BAL_REPLY_MS) { ++gErrors; gWaiting = false; }
+    if (!gWaiting && now - gSentMs >= BAL_POLL_MS) {
+        gPort.print(F("SI\r\n"));
+        gSentMs  = now;
+        gWaiting = true;
+    }
+#else
+    (void)now;                                      // push() delivers
+#endif
+}
+
+bool push(float g, bool stable, uint32_t now)
+{
+    if (!gOpen || BAL_UART) return false;           // only the relay path
+    gReading = {g, stable, now};
+    gFresh   = true;
+    return true;
+}
+
+bool pop(Reading& r)
+{
+    if (!gFresh) return false;
+    r = gReading;
+    gFresh = false;
+    return true;
+}
+
+uint16_t errors() { return gErrors; }
+
+}   // namespace Balance
@@ -0,0 +1,40 @@
+#pragma once
+/*  balance.hpp – serial lab balance (MT-SICS subset)
+ *  -------------------------------------------------
+ *  Non-blocking: poll() sends "SI\r\n" (weight, immediately) every
+ *  BAL_POLL_MS and parses whatever reply bytes have arrived.
+ *
+ *      → SI                      ← S S      12.3456 g   stable
+ *                                ← S D      12.3458 g   dynamic
+ *                                ← S I / S + / S -      busy / range
+ *
+ *  A reading is stamped with the time its request went out (the
+ *  balance samples on receipt), so the round trip adds no skew.
+ *  Any emulator that answers the same lines will do, see
+ *  test/test_balance_stub.
+ *
+ *  Without BAL_UART_PINS (the XIAO: no UART pad is free, pins.hpp)
+ *  there is no port; the host polls the balance and relays each
+ *  weight with "G W <g>", which lands in push() stamped on arrival.
+ *  USB adds a few ms of skew, small against GCAL_BAL_LAG_MS.
+ */
+
+#include <stdint.h>
+
+namespace Balance {
+
+struct Reading {
+    float    g;
+    bool     stable;
+    uint32_t t_ms;
+};
+
+void     begin();                   // open UART1 (BAL_BAUD) / the relay
+void     end();
+void     poll(uint32_t now_ms);     // call every tick while open
+bool     pop(Reading& r);           // latest unread reading
+bool     push(float g, bool stable, uint32_t now_ms);   // host relay
+
+uint16_t errors();                  // bad / error / timed-out replies
+
+}   // namespace Balance
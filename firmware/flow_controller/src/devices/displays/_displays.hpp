@@ -1,4 +1,5 @@
 #pragma once
 
 #include "sh1107/sh1107.hpp"
-//#include "ssd1306/ssd1306.hpp"
+#include "ssd1306/ssd1306.hpp"
+#include "null_display/null_display.hpp"
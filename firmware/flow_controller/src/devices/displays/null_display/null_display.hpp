@@ -0,0 +1,13 @@
+#pragma once
+/*  null_display.hpp – headless stand-in for Sh1107Display
+ *  Same interface, empty bodies: every call inlines to nothing.
+ */
+
+#include "../../../include/_include.hpp"
+
+class NullDisplay {
+public:
+    bool begin()                             { return true; }
+    void advancePage()                       {}
+    void show(const volatile SystemState&)   {}
+};
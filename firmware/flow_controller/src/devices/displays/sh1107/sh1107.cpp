@@ -2,13 +2,33 @@
 #include "../../../ctrl/exp_ctrl/egc_calibration_config.hpp"   // CAL_TOTAL_MS
 #include "../../../min_main.hpp"     // SystemState, etc.
 
-#ifdef ENABLE_SH1107
 
 /* ───── helpers ───────────────────────────────────────── */
 
 /* CP-437 ± symbol */
-static inline void printPlusMinus(Adafruit_SH1107& d)
-{ d.print((char)241); }
+static constexpr char PLUS_MINUS[] = {(char)241, '\0'};
+
+/* right-aligned decimal into out[0..n), saturating at the box width */
+static void formatInt(int32_t v, char* out, uint8_t n)
+{
+    int32_t lim = 1;
+    for (uint8_t i = 0; i < n; ++i) lim *= 10;
+    if (v >= lim)           v = lim - 1;
+    if (v <= -(lim / 10))   v = -(lim / 10) + 1;
+
+    bool     neg = v < 0;
+    uint32_t u   = neg ? -v : v;
+    int8_t   i   = n - 1;
+    do { out[i--] = '0' + u % 10; u /= 10; } while (u && i >= 0);
+    if (neg && i >= 0) out[i--] = '-';
+    while (i >= 0) out[i--] = ' ';
+}
+
+static inline int32_t roundToInt(float v)
+{
+    if (!(v > -1e9f && v < 1e9f)) return 0;      // also catches NaN
+    return static_cast<int32_t>(v < 0 ? v - 0.5f : v + 0.5f);
+}
 
 /* ───── public interface ─────────────────────────────── */
 bool Sh1107Display::begin()
@@ -19,8 +39,10 @@ bool Sh1107Display::begin()
     mDisp.setRotation(1);
     mDisp.setTextColor(SH110X_WHITE);
     mDisp.setTextWrap(false);
+    buildGlyphCache();
     mDisp.clearDisplay();
     mDisp.display();
+    mShown = NO_PAGE;
     return true;
 }
 
@@ -29,159 +51,204 @@ void Sh1107Display::advancePage() { mPage = (mPage + 1) % PAGES; }
 /* ───── dispatcher ───────────────────────────────────── */
 void Sh1107Display::show(const volatile SystemState& s)
 {
-    if (s.calibrating) {          // modal progress bar overrides pages
-        drawCalProgress();
-        mDisp.display();
-        return;
+    uint8_t page = s.calibrating ? CAL_MODAL : mPage;   // modal bar overrides
+    bool    full = page != mShown;
+    if (full) {
+        mDisp.clearDisplay();
+        mDisp.setFont();
+        for (Field& f : mField) f = Field{};
+        mShown = page;
+        mDirty = true;
     }
 
-    switch (mPage) {
-        case 0: drawSetFlowPage   (s); break;
-        case 1: drawMeasuredPage  (s); break;
-        case 2: drawCalScalarPage (s); break;
-        default: drawInitCalPage  (s); break;
+    switch (page) {
+        case 0:         drawSetFlowPage   (s, full); break;
+        case 1:         drawMeasuredPage  (s, full); break;
+        case 2:         drawCalScalarPage (s, full); break;
+        case CAL_MODAL: drawCalProgress   (full);    break;
+        default:        drawInitCalPage   (s, full); break;
     }
-    mDisp.display();
+
+    if (mDirty) { mDisp.display(); mDirty = false; }
 }
 
 /* ───── page helpers ─────────────────────────────────── */
-void Sh1107Display::drawSetFlowPage(const volatile SystemState& s)
+void Sh1107Display::drawSetFlowPage(const volatile SystemState& s, bool full)
 {
-    mDisp.clearDisplay();
-    mDisp.setFont();
-
-    /* top: raw flow preview */
-    mDisp.setCursor(0, 0);
-    mDisp.print(F("Meas "));
-    mDisp.print(s.r_flow, 0);
-    mDisp.print(F(" uL/min"));
-
-    /* centre: set-point */
-    char buf[20];
-    snprintf(buf, sizeof(buf), "%.0f uL/min", s.setpoint);
-    mDisp.setTextSize(2);
-    int16_t bx, by; uint16_t bw, bh;
-    mDisp.getTextBounds(buf, 0, 0, &bx, &by, &bw, &bh);
-    mDisp.setCursor((mDisp.width() - bw) / 2,
-                    (mDisp.height() - bh) / 2 - 4);
-    mDisp.print(buf);
-    mDisp.setTextSize(1);
-
-    /* bottom: cal-scalar */
-    mDisp.setCursor(0, mDisp.height() - 8);
-    mDisp.print(F("Cal "));
-    printPlusMinus(mDisp);
-    mDisp.print(s.calScalar, 0);
-    mDisp.print('%');
+    if (full) {
+        /* top: raw flow preview */
+        label(0, 0, 1, "Meas");       field(0, 30, 0, 1, 5);  label(66, 0, 1, "uL/min");
+        /* centre: set-point */
+        field(1, 16, 20, 2, 4);       label(68, 28, 1, "uL/min");
+        /* bottom: cal-scalar */
+        label(0, 56, 1, "Cal ");      label(24, 56, 1, PLUS_MINUS);
+        field(2, 30, 56, 1, 4);       label(54, 56, 1, "%");
+    }
+    update(0, s.r_flow);
+    update(1, s.setpoint);
+    update(2, s.calScalar);
 }
 
-void Sh1107Display::drawMeasuredPage(const volatile SystemState& s)
+void Sh1107Display::drawMeasuredPage(const volatile SystemState& s, bool full)
 {
-    mDisp.clearDisplay();
-    mDisp.setFont();
-
-    /* top: set-point */
-    mDisp.setCursor(0, 0);
-    mDisp.print(F("Set "));
-    mDisp.print(s.setpoint, 0);
-    mDisp.print(F(" uL/min"));
-
-    /* centre: filtered flow */
-    char buf[20];
-    snprintf(buf, sizeof(buf), "%.0f uL/min", s.f_flow);
-    mDisp.setTextSize(2);
-    int16_t bx, by; uint16_t bw, bh;
-    mDisp.getTextBounds(buf, 0, 0, &bx, &by, &bw, &bh);
-    mDisp.setCursor((mDisp.width() - bw) / 2,
-                    (mDisp.height() - bh) / 2 - 4);
-    mDisp.print(buf);
-    mDisp.setTextSize(1);
-
-    /* bottom: cal-scalar */
-    mDisp.setCursor(0, mDisp.height() - 8);
-    mDisp.print(F("Cal "));
-    printPlusMinus(mDisp);
-    mDisp.print(s.calScalar, 0);
-    mDisp.print('%');
+    if (full) {
+        /* top: set-point */
+        label(0, 0, 1, "Set");        field(0, 30, 0, 1, 5);  label(66, 0, 1, "uL/min");
+        /* centre: filtered flow */
+        field(1, 16, 20, 2, 4);       label(68, 28, 1, "uL/min");
+        /* bottom: cal-scalar */
+        label(0, 56, 1, "Cal ");      label(24, 56, 1, PLUS_MINUS);
+        field(2, 30, 56, 1, 4);       label(54, 56, 1, "%");
+    }
+    update(0, s.setpoint);
+    update(1, s.f_flow);
+    update(2, s.calScalar);
 }
 
-void Sh1107Display::drawCalScalarPage(const volatile SystemState& s)
+void Sh1107Display::drawCalScalarPage(const volatile SystemState& s, bool full)
 {
-    mDisp.clearDisplay();
-    mDisp.setFont();
-
-    /* top: set-point */
-    mDisp.setCursor(0, 0);
-    mDisp.print(F("Set "));
-    mDisp.print(s.setpoint, 0);
-    mDisp.print(F(" uL/min"));
-
-    /* centre: ±cal-scalar */
-    char buf[16];
-    buf[0] = 241;   // ±
-    snprintf(buf + 1, sizeof(buf) - 1, "%.0f %%", s.calScalar);
-    mDisp.setTextSize(2);
-    int16_t bx, by; uint16_t bw, bh;
-    mDisp.getTextBounds(buf, 0, 0, &bx, &by, &bw, &bh);
-    mDisp.setCursor((mDisp.width() - bw) / 2,
-                    (mDisp.height() - bh) / 2 - 4);
-    mDisp.print(buf);
-    mDisp.setTextSize(1);
-
-    /* bottom: raw flow preview */
-    mDisp.setCursor(0, mDisp.height() - 8);
-    mDisp.print(F("Meas "));
-    mDisp.print(s.r_flow, 0);
-    mDisp.print(F(" uL/min"));
+    if (full) {
+        /* top: set-point */
+        label(0, 0, 1, "Set");        field(0, 30, 0, 1, 5);  label(66, 0, 1, "uL/min");
+        /* centre: ±cal-scalar */
+        label(28, 20, 2, PLUS_MINUS); field(1, 40, 20, 2, 3); label(80, 20, 2, "%");
+        /* bottom: raw flow preview */
+        label(0, 56, 1, "Meas");      field(2, 30, 56, 1, 5); label(66, 56, 1, "uL/min");
+    }
+    update(0, s.setpoint);
+    update(1, s.calScalar);
+    update(2, s.r_flow);
 }
 
-void Sh1107Display::drawInitCalPage(const volatile SystemState&)
+void Sh1107Display::drawInitCalPage(const volatile SystemState&, bool full)
 {
-    mDisp.clearDisplay();
-    mDisp.setFont();
+    if (!full) return;                  // nothing live on this page
 
     const char* msg = "Init Cal?";
     mDisp.setTextSize(2);
     int16_t bx, by; uint16_t bw, bh;
     mDisp.getTextBounds(msg, 0, 0, &bx, &by, &bw, &bh);
-    mDisp.setCursor((mDisp.width() - bw) / 2,
-                    (mDisp.height() - bh) / 2 - 4);
-    mDisp.print(msg);
-    mDisp.setTextSize(1);
+    label((mDisp.width() - bw) / 2, (mDisp.height() - bh) / 2 - 4, 2, msg);
 
-    mDisp.setCursor(0, mDisp.height() - 8);
-    mDisp.print(F("Hold 5s to run"));
+    label(0, mDisp.height() - 8, 1, "Hold 5s to run");
 }
 
 /* ───── calibration progress bar ─────────────────────── */
-void Sh1107Display::drawCalProgress()
+void Sh1107Display::drawCalProgress(bool full)
 {
     extern volatile uint32_t gCalibStart;
 
-    mDisp.clearDisplay();
-    mDisp.setFont();
+    constexpr int BAR_W = 100, BAR_H = 6;
+    const int x = (mDisp.width()  - BAR_W) / 2;
+    const int y = (mDisp.height() - BAR_H) / 2;
 
-    mDisp.setCursor(0, 0);
-    mDisp.print(F("Calibrating…"));
+    if (full) {
+        label(0, 0, 1, "Calibrating…");
+        mDisp.drawRect(x, y, BAR_W, BAR_H, SH110X_WHITE);
+        field(0, 52, y + BAR_H + 4, 1, 3);  label(70, y + BAR_H + 4, 1, "%");
+    }
 
     uint32_t elapsed = millis() - gCalibStart;
     if (elapsed > CAL_TOTAL_MS) elapsed = CAL_TOTAL_MS;
-    float pct = elapsed * 100.0f / CAL_TOTAL_MS;
+    int32_t pct = static_cast<int32_t>(elapsed * 100ULL / CAL_TOTAL_MS);
 
-    constexpr int BAR_W = 100, BAR_H = 6;
-    int filled = static_cast<int>(BAR_W * pct / 100.0f);
-    int x = (mDisp.width()  - BAR_W) / 2;
-    int y = (mDisp.height() - BAR_H) / 2;
-
-    mDisp.drawRect(x, y, BAR_W, BAR_H, SH110X_WHITE);
+    /* the bar only grows, and only with the percentage */
+    if (mField[0].valid && mField[0].shown == pct) return;
+    int filled = BAR_W * pct / 100;
     if (filled > 2)
         mDisp.fillRect(x + 1, y + 1, filled - 2, BAR_H - 2, SH110X_WHITE);
+    update(0, pct);
+}
 
-    char buf[8]; snprintf(buf, sizeof(buf), "%3.0f%%", pct);
-    int16_t bx, by; uint16_t bw, bh;
-    mDisp.getTextBounds(buf, 0, 0, &bx, &by, &bw, &bh);
-    mDisp.setCursor((mDisp.width() - bw) / 2, y + BAR_H + 4);
-    mDisp.print(buf);
+/* ───── page model ───────────────────────────────────── */
+
+/* Render each cached glyph once through GFX and read it back, so the
+   cache is the library's own font, pixel for pixel.               */
+void Sh1107Display::buildGlyphCache()
+{
+    for (uint8_t sz = 1; sz <= 2; ++sz) {
+        GlyphSet& gs = mGlyph[sz - 1];
+        gs.w = 6 * sz;  gs.h = 8 * sz;
+        for (uint8_t g = 0; g < N_GLYPHS; ++g) {
+            mDisp.fillRect(0, 0, gs.w, gs.h, SH110X_BLACK);
+            mDisp.drawChar(0, 0, GLYPHS[g], SH110X_WHITE, SH110X_BLACK, sz);
+            for (uint8_t r = 0; r < gs.h; ++r) {
+                uint16_t bits = 0;
+                for (uint8_t c = 0; c < gs.w; ++c)
+                    if (mDisp.getPixel(c, r)) bits |= 1u << c;
+                gs.rows[g][r] = bits;
+            }
+        }
+    }
+}
+
+void Sh1107Display::label(int16_t x, int16_t y, uint8_t size, const char* txt)
+{
+    mDisp.setTextSize(size);
+    mDisp.setCursor(x, y);
+    mDisp.print(txt);
+    mDisp.setTextSize(1);
 }
 
-#endif // ENABLE_SH1107
\ No newline at end of file
+void Sh1107Display::field(uint8_t i, uint8_t x, uint8_t y, uint8_t size, uint8_t chars)
+{
+    mField[i] = Field{x, y, size, chars, 0, false};
+}
+
+void Sh1107Display::update(uint8_t i, float v)
+{
+    Field&  f = mField[i];
+    int32_t n = roundToInt(v);
+    if (f.valid && f.shown == n) return;
+
+    char txt[8];
+    formatInt(n, txt, f.chars);
+    blit(f, txt);
+    f.shown = n;
+    f.valid = true;
+    mDirty  = true;
+}
+
+/* With rotation 1 a logical row is a raw column, and 8 horizontally
+   adjacent logical pixels (x&~7 … x|7) share one buffer byte, LSB
+   leftmost: byte (RAW_W-1-y) + (x/8)·RAW_W.  Each box row is built
+   as one 64-bit word and merged into the bytes it overlaps.       */
+void Sh1107Display::blit(const Field& f, const char* txt)
+{
+    const GlyphSet& gs = mGlyph[f.size - 1];
+    uint8_t idx[8];
+    for (uint8_t i = 0; i < f.chars; ++i) {
+        const char* p = strchr(GLYPHS, txt[i]);
+        idx[i] = p ? p - GLYPHS : 0;
+    }
+
+    const uint8_t  off   = f.x & 7;
+    const uint8_t  width = f.chars * gs.w;
+    const uint64_t mask  = ((width < 64 ? (1ULL << width) : 0) - 1) << off;
+    const uint8_t  b0    = f.x >> 3, b1 = (f.x + width - 1) >> 3;
+
+    uint8_t* buf = mDisp.getBuffer();
+    for (uint8_t r = 0; r < gs.h; ++r) {
+        uint64_t bits = 0;
+        for (uint8_t i = 0; i < f.chars; ++i)
+            bits |= static_cast<uint64_t>(gs.rows[idx[i]][r]) << (i * gs.w);
+        bits <<= off;
+
+        uint8_t* col = buf + (RAW_W - 1 - (f.y + r));
+        for (uint8_t b = b0; b <= b1; ++b) {
+            uint8_t m = mask >> ((b - b0) * 8);
+            uint8_t v = bits >> ((b - b0) * 8);
+            col[b * RAW_W] = (col[b * RAW_W] & ~m) | (v & m);
+        }
+    }
+
+    mDisp.touch(RAW_W - f.y - gs.h, f.x, RAW_W - 1 - f.y, f.x + width - 1);
+}
+
+void Sh1107Display::Panel::touch(int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+    if (x1 < window_x1) window_x1 = x1;
+    if (y1 < window_y1) window_y1 = y1;
+    if (x2 > window_x2) window_x2 = x2;
+    if (y2 > window_y2) window_y2 = y2;
+}
@@ -3,6 +3,11 @@
 #include <Adafruit_SH110X.h>
 #include "../../../include/_include.hpp"
 
+/*  Page model: labels are drawn through GFX once per page change;
+ *  each numeric value sits in a fixed box and is redrawn from a
+ *  glyph cache only when its integer changes, as whole bytes of the
+ *  frame buffer.  Frames with no change skip the I²C transfer, and
+ *  a changed frame only sends the rows it touched.               */
 class Sh1107Display {
 public:
     bool  begin();
@@ -10,16 +15,48 @@ public:
     void  show(const volatile SystemState& s);
 
 private:
-    /* ----- per-page draw helpers ----- */
-    void drawSetFlowPage   (const volatile SystemState& s);  // page 0
-    void drawMeasuredPage  (const volatile SystemState& s);  // page 1
-    void drawCalScalarPage (const volatile SystemState& s);  // page 2  (± Cal %)
-    void drawInitCalPage   (const volatile SystemState& s);  // page 3
-    void drawCalProgress   ();                               // modal progress bar
-
-    static constexpr uint8_t I2C_ADDR = 0x3C;
-    static constexpr uint8_t PAGES    = 4;   // SET | MEAS | CAL% | CAL
-
-    Adafruit_SH1107 mDisp {64, 128, &Wire, -1, 1'000'000};
-    uint8_t         mPage = 0;
+    /* SH1107 with write access to the dirty window, so blits made
+       straight into the frame buffer are still sent by display() */
+    struct Panel : Adafruit_SH1107 {
+        using Adafruit_SH1107::Adafruit_SH1107;
+        void touch(int16_t x1, int16_t y1, int16_t x2, int16_t y2);  // raw coords
+    };
+
+    /* glyphs for numeric boxes, at text size 1 (6×8) and 2 (12×16);
+       one bit row per scan line, LSB = leftmost pixel              */
+    static constexpr char    GLYPHS[]   = " 0123456789-";
+    static constexpr uint8_t N_GLYPHS   = sizeof(GLYPHS) - 1;
+    struct GlyphSet { uint8_t w, h; uint16_t rows[N_GLYPHS][16]; };
+
+    /* right-aligned integer in a fixed box; x + chars·w ≤ x&~7 + 64 */
+    struct Field { uint8_t x, y, size, chars; int32_t shown; bool valid; };
+    static constexpr uint8_t MAX_FIELDS = 3;
+
+    /* ----- per-page draw helpers (full = page just changed) ----- */
+    void drawSetFlowPage   (const volatile SystemState& s, bool full);  // page 0
+    void drawMeasuredPage  (const volatile SystemState& s, bool full);  // page 1
+    void drawCalScalarPage (const volatile SystemState& s, bool full);  // page 2  (± Cal %)
+    void drawInitCalPage   (const volatile SystemState& s, bool full);  // page 3
+    void drawCalProgress   (bool full);                                 // modal progress bar
+
+    /* ----- page model ----- */
+    void buildGlyphCache();
+    void label(int16_t x, int16_t y, uint8_t size, const char* txt);
+    void field(uint8_t i, uint8_t x, uint8_t y, uint8_t size, uint8_t chars);
+    void update(uint8_t i, float v);        // redraw box i if round(v) changed
+    void blit(const Field& f, const char* txt);
+
+    static constexpr uint8_t I2C_ADDR  = 0x3C;
+    static constexpr uint8_t PAGES     = 4;      // SET | MEAS | CAL% | CAL
+    static constexpr uint8_t CAL_MODAL = PAGES;  // pseudo-page for the bar
+    static constexpr uint8_t NO_PAGE   = 0xFF;
+    static constexpr int16_t RAW_W     = 64;     // panel width before rotation
+
+    Panel    mDisp {64, 128, &Wire, -1, 1'000'000};
+    uint8_t  mPage  = 0;
+    uint8_t  mShown = NO_PAGE;                  // page currently composed
+    bool     mDirty = false;                    // frame buffer needs sending
+
+    GlyphSet mGlyph[2] {};
+    Field    mField[MAX_FIELDS] {};
 };
@@ -1,88 +1,64 @@
 /*
- * File: display.cpp
+ * File: ssd1306.cpp
  * Brief: Manages the SSD1306 display for system status reporting.
  */
 
- #include "ssd1306.hpp"
- #include "../../../include/_include.hpp"
- #include <Wire.h>
- #include <Adafruit_GFX.h>
- #include <Adafruit_SSD1306.h>
+#include "ssd1306.hpp"
+#include <Wire.h>
 
-#ifdef ENABLE_SSD1306
- 
- // Display configuration
- static const int SCREEN_WIDTH  = 128;
- static const int SCREEN_HEIGHT = 64;
- static Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
- 
- // Tracks whether the display was successfully initialized
- static bool displayInited = false;
- 
- /*
-  * Function: initDisplay
-  * Brief: Initializes the SSD1306 display with the address from config.h.
-  * Returns: True if successful, false otherwise.
-  */
- bool initDisplay() {
-   if (!display.begin(SSD1306_SWITCHCAPVCC, SSD1306_DISPLAY_ADDR)) {
-     displayInited = false;
-     return false;
-   }
-   display.setRotation(2);
-   display.clearDisplay();
-   display.display();
-   displayInited = true;
-   return true;
- }
- 
- /*
-  * Function: showStatus
-  * Brief: Displays flow rate, setpoint, error %, voltage, temperature, 
-  *        bubble detection status, and system power state.
-  */
- void showStatus(float flow,
-                 float setpoint,
-                 float errorPct,
-                 float bartelsVoltage,
-                 bool systemOn,
-                 float temperature,
-                 bool bubbleDetected)
- {
-   if (!displayInited) return;
- 
-   display.clearDisplay();
-   display.setTextSize(1);
-   display.setTextColor(SSD1306_WHITE);
-   display.setCursor(0, 0);
- 
-   display.print("Flow: ");
-   display.print(flow, 3);
-   display.println(" mL/min");
- 
-   display.print("Setpt: ");
-   display.print(setpoint, 3);
-   display.println(" mL/min");
- 
-   display.print("Err%: ");
-   display.print(errorPct, 1);
-   display.println();
- 
-   display.print("Volt: ");
-   display.print(bartelsVoltage, 1);
-   display.println();
- 
-   display.print("Temp: ");
-   display.print(temperature, 1);
-   display.println(" C");
- 
-   display.print("Bubble: ");
-   display.println(bubbleDetected ? "YES" : "NO");
- 
-   display.print("System: ");
-   display.println(systemOn ? "ON" : "OFF");
- 
-   display.display();
- }
- 
-#endif // ENABLE_SSD1306_DISPLAY
\ No newline at end of file
+/*
+ * Function: begin
+ * Brief: Initializes the SSD1306 display with the address from config.hpp.
+ * Returns: True if successful, false otherwise.
+ */
+bool Ssd1306Display::begin()
+{
+    if (!mDisp.begin(SSD1306_SWITCHCAPVCC, SSD1306_DISPLAY_ADDR)) {
+        mInited = false;
+        return false;
+    }
+    mDisp.setRotation(2);
+    mDisp.clearDisplay();
+    mDisp.display();
+    mInited = true;
+    return true;
+}
+
+/*
+ * Function: show
+ * Brief: Displays flow rate, set-point, cal scalar, delivered volume,
+ *        bubble status and pump state.
+ */
+void Ssd1306Display::show(const volatile SystemState& s)
+{
+    if (!mInited) return;           // no frame buffer before begin()
+
+    mDisp.clearDisplay();
+    mDisp.setTextSize(1);
+    mDisp.setTextColor(SSD1306_WHITE);
+    mDisp.setCursor(0, 0);
+
+    mDisp.print("Flow: ");
+    mDisp.print(s.f_flow, 1);
+    mDisp.println(" uL/min");
+
+    mDisp.print("Setpt: ");
+    mDisp.print(s.progSp, 1);
+    mDisp.println(" uL/min");
+
+    mDisp.print("Cal%: ");
+    mDisp.print(s.calScalar, 1);
+    mDisp.println();
+
+    mDisp.print("Vol: ");
+    mDisp.print(s.volume_uL, 0);
+    mDisp.println(" uL");
+
+    mDisp.print("Bubble: ");
+    mDisp.println(s.bubble ? "YES" : "NO");
+
+    mDisp.print("Pump: ");
+    mDisp.println(s.pumpEnabled ? "ON" : "OFF");
+
+    mDisp.display();
+}
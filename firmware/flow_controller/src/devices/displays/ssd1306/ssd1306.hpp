@@ -1,19 +1,24 @@
 #pragma once
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "../../../include/_include.hpp"
 
 /*
- * File: display.h
- * Brief: Declarations for initializing and updating the SSD1306 display.
+ * File: ssd1306.hpp
+ * Brief: 128×64 SSD1306 status display.  Same interface as
+ *        Sh1107Display so either can be picked in build_config.hpp.
  */
 
-// Initializes the SSD1306 display. Returns true if successful.
-bool initDisplay();
+class Ssd1306Display {
+public:
+    bool  begin();                                  // true if the panel answered
+    void  advancePage() {}                          // single status page
+    void  show(const volatile SystemState& s);
 
-// Displays key status parameters (flow, setpoint, error%, voltage, temperature,
-// bubble detection, system on/off state).
-void showStatus(float flow,
-                float setpoint,
-                float errorPct,
-                float bartelsVoltage,
-                bool systemOn,
-                float temperature,
-                bool bubbleDetected);
+private:
+    static constexpr int WIDTH  = 128;
+    static constexpr int HEIGHT = 64;
+
+    Adafruit_SSD1306 mDisp {WIDTH, HEIGHT, &Wire, -1};
+    bool             mInited = false;
+};
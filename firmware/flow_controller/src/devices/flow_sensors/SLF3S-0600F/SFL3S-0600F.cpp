@@ -1,5 +1,19 @@
 /*  SFL3S-0600F.cpp  –  minimal flow-sensor driver
  *  Returns compensated flow in µL·min⁻¹.
+ *
+ *  Link recovery runs inside readSample(), one step per call, so it
+ *  never blocks the tick for more than one I²C transaction (plus a
+ *  ≤ 100 µs SCL bus-clear):
+ *
+ *    MEASURE ──(SENS_ERR_LIMIT errors | SENS_STALE_MS)─▶ BUS_CLEAR
+ *    BUS_CLEAR: 9×SCL + STOP, Wire re-init, stop cmd ────▶ STOPPING
+ *    STOPPING ──(SENS_RESTART_GAP_MS)── start ok ────────▶ MEASURE
+ *                                       start failed ────▶ BACKOFF
+ *    BACKOFF  ──(50 ms · 2ⁿ, ≤ SENS_BACKOFF_MAX_MS) ─────▶ BUS_CLEAR
+ *
+ *  Every call returns a Sample.  Without a fresh reading the value
+ *  and timestamp are those of the last good one, tagged HELD plus
+ *  the cause (IO_ERR / OFFLINE); warm-up frames are fresh but WARMUP.
  */
 
 #include "../../../include/_include.hpp"          // State helpers
@@ -7,8 +21,6 @@
 #include <SensirionI2cSf06Lf.h>                   // driver first
 #include "SFL3S-0600F.hpp"
 
-#ifdef ENABLE_SFL3S_0600F
-
 /* ───── constants ───────────────────────────────────────── */
 static constexpr uint8_t I2C_ADDR = SLF3S_0600F_I2C_ADDR_08;   // 0x08
 
@@ -22,8 +34,10 @@ static constexpr Sf06LfInvFlowScaleFactors INV_SCALE =
 #endif
 
 /* ───── local state ─────────────────────────────────────── */
+enum class Phase : uint8_t { OFF, MEASURE, BUS_CLEAR, STOPPING, BACKOFF };
+
 static SensirionI2cSf06Lf _flow;
-static bool     _measuring     = false;
+static Phase    _phase         = Phase::OFF;
 static int16_t  _driverErr     = 0;
 
 static float    _rawFlow_uLmin = 0.0f;
@@ -31,50 +45,185 @@ static float    _rawTempC      = 0.0f;
 static uint16_t _lastFlags     = 0;
 static uint16_t _readCount     = 0;      // skip first 3 frames
 
+static Sample   _held;                   // last good sample
+static uint32_t _lastGoodMs    = 0;
+static uint32_t _phaseMs       = 0;      // entry time of the current phase
+static uint8_t  _failures      = 0;      // failed restarts in a row
+static Hal::SensorHealth _health;
+
+/* ───── recovery helpers ────────────────────────────────── */
+
+/* free a slave stuck mid-byte: clock SCL until it lets go of
+   SDA, then issue STOP.  Open-drain emulated with pinMode.       */
+static void busClear()
+{
+    Wire.end();
+    pinMode(I2C_SDA_PIN, INPUT_PULLUP);
+    pinMode(I2C_SCL_PIN, INPUT_PULLUP);
+
+    for (uint8_t i = 0; i < 9 && !digitalRead(I2C_SDA_PIN); ++i) {
+        digitalWrite(I2C_SCL_PIN, LOW); pinMode(I2C_SCL_PIN, OUTPUT);
+        delayMicroseconds(5);
+        pinMode(I2C_SCL_PIN, INPUT_PULLUP);
+        delayMicroseconds(5);
+    }
+    digitalWrite(I2C_SDA_PIN, LOW); pinMode(I2C_SDA_PIN, OUTPUT);   // STOP
+    delayMicroseconds(5);
+    pinMode(I2C_SDA_PIN, INPUT_PULLUP);
+    delayMicroseconds(5);
+
+    Wire.begin(); Wire.setClock(400'000);
+}
+
+static void enter(Phase p, uint32_t now)
+{
+    _phase   = p;
+    _phaseMs = now;
+}
+
+static void beginRecovery(uint32_t now)
+{
+    if (_health.state == Hal::SensorState::OK)
+        _health.state = Hal::SensorState::RECOVERING;
+    enter(Phase::BUS_CLEAR, now);
+}
+
+static void startFailed(uint32_t now)
+{
+    if (_failures < 255) ++_failures;
+    if (_failures >= SENS_FAIL_AFTER) _health.state = Hal::SensorState::FAILED;
+    enter(Phase::BACKOFF, now);
+}
+
+static uint32_t backoffMs()
+{
+    uint8_t  n = _failures ? _failures - 1 : 0;
+    uint32_t b = n < 6 ? SENS_BACKOFF_MIN_MS << n : SENS_BACKOFF_MAX_MS;
+    return b < SENS_BACKOFF_MAX_MS ? b : SENS_BACKOFF_MAX_MS;
+}
+
+/* one step of the recovery machine */
+static void service(uint32_t now)
+{
+    switch (_phase) {
+        case Phase::BUS_CLEAR:
+            busClear();
+            ++_health.busClears;
+            _flow.begin(Wire, I2C_ADDR);
+            _flow.stopContinuousMeasurement();  // may fail; start decides
+            enter(Phase::STOPPING, now);
+            break;
+
+        case Phase::STOPPING:
+            if (now - _phaseMs < SENS_RESTART_GAP_MS) break;
+            _driverErr = _flow.startH2oContinuousMeasurement();
+            if (_driverErr) { startFailed(now); break; }
+            ++_health.restarts;
+            _health.consecutive = 0;
+            _readCount  = 0;
+            _lastGoodMs = now;
+            enter(Phase::MEASURE, now);
+            break;
+
+        case Phase::BACKOFF:
+            if (now - _phaseMs >= backoffMs()) enter(Phase::BUS_CLEAR, now);
+            break;
+
+        default: break;
+    }
+}
+
 /* ───── API implementation ──────────────────────────────── */
 bool startFlowMeasurement()
 {
+    uint32_t now = millis();
     Wire.begin();
     _flow.begin(Wire, I2C_ADDR);
     _flow.stopContinuousMeasurement();
     delay(5);
 
-    _driverErr = _flow.startH2oContinuousMeasurement();
-    _measuring = (_driverErr == 0);
-    _readCount = 0;
-    return _measuring;
+    _driverErr  = _flow.startH2oContinuousMeasurement();
+    _readCount  = 0;
+    _lastGoodMs = now;
+    _failures   = 0;
+    if (_driverErr) {                       // keep retrying in the background
+        startFailed(now);
+        return false;
+    }
+    enter(Phase::MEASURE, now);
+    return true;
 }
 
 bool stopFlowMeasurement()
 {
-    if (!_measuring) return true;
+    if (_phase == Phase::OFF) return true;
+    bool wasMeasuring = (_phase == Phase::MEASURE);
+    _phase = Phase::OFF;
+    if (!wasMeasuring) return true;
     _driverErr = _flow.stopContinuousMeasurement();
-    _measuring = false;
     return (_driverErr == 0);
 }
 
-float readFlow()   /* compensated, µL·min⁻¹ */
+/* last good value, re-stamped with why there is no fresh one */
+static Sample held(uint8_t why)
 {
-    if (!_measuring) return 0.0f;
+    Sample h = _held;
+    h.q = why | SampleQ::HELD;
+    return h;
+}
+
+Sample readSample()   /* compensated, µL·min⁻¹ */
+{
+    uint32_t now = millis();
+
+    if (_phase == Phase::OFF) return held(SampleQ::OFFLINE);
+    if (_phase != Phase::MEASURE) { service(now); return held(SampleQ::OFFLINE); }
 
     int16_t err = _flow.readMeasurementData(
                       INV_SCALE,
                       _rawFlow_uLmin,
                       _rawTempC,
                       _lastFlags);
-    if (err) { _driverErr = err; return 0.0f; }
+    if (err) {
+        _driverErr = err;
+        ++_health.readErrors;
+        if (_health.consecutive < 255) ++_health.consecutive;
 
-    if (++_readCount <= 3) return 0.0f;   // warm-up discard
+        /* slow (timed-out) transfers stretch the tick, so also
+           bound the outage in time, not just in error count */
+        bool stale = (now - _lastGoodMs > SENS_STALE_MS);
+        if (stale) ++_health.staleEvents;
+        if (stale || _health.consecutive >= SENS_ERR_LIMIT) beginRecovery(now);
+        return held(SampleQ::IO_ERR);
+    }
+    _health.consecutive = 0;
+    _lastGoodMs = now;
 
-    /* apply user ±cal-scalar (%) */
+    /* apply user ±cal-scalar (%) – a trim; MinCtrl applies CalCurve */
     float factor = 1.0f /
                    (1.0f - State::getCalScalar() / 100.0f);
-    return _rawFlow_uLmin * factor;       // µL·min⁻¹
+
+    Sample s;
+    s.value = _rawFlow_uLmin * factor;      // µL·min⁻¹
+    s.t_us  = State::nowUs();
+    s.q     = SampleQ::fromSlf(_lastFlags);
+
+    if (++_readCount <= 3) {                // warm-up discard
+        s.q |= SampleQ::WARMUP;
+        return s;
+    }
+    _failures     = 0;
+    _health.state = Hal::SensorState::OK;
+
+    if (s.good()) _held = s;
+    return s;
 }
 
+float readFlow() { return readSample().value; }
+
 /* ───── simple accessors ───────────────────────────────── */
 float     getTempC()     { return _rawTempC; }
 uint16_t  getLastFlags() { return _lastFlags; }
 float     getRawFlow()   { return _rawFlow_uLmin; }   // µL·min⁻¹
 
-#endif /* ENABLE_SFL3S_0600F */
+const Hal::SensorHealth& sensorHealth() { return _health; }
@@ -2,29 +2,44 @@
 /*  SFL3S-0600F.hpp  –  wrapper for Sensirion SLF3S-0600F
  *  All flow values are in µL·min⁻¹.
  *
- *  Functions (enabled when ENABLE_SFL3S_0600F is defined):
+ *  Functions:
  *      startFlowMeasurement / stopFlowMeasurement
- *      readFlow()           -> compensated, µL·min⁻¹
+ *      readSample()         -> compensated µL·min⁻¹ + time + quality
+ *      readFlow()           -> readSample().value
  *      getTempC()           -> °C
  *      getLastFlags()       -> status bits
  *      getRawFlow()         -> un-compensated, µL·min⁻¹
+ *      sensorHealth()       -> link state + fault counters
+ *
+ *  readSample() also drives the non-blocking I²C recovery; call it
+ *  every tick even while the link is down.
  */
 
 #include <stdint.h>
+#include "../../hal/hal.hpp"
+#include "../../../core/sample/sample.hpp"
 
 /* Provide the default I²C address only if the driver header lacks it */
 #ifndef SLF3S_0600F_I2C_ADDR_08
 #define SLF3S_0600F_I2C_ADDR_08 0x08
 #endif
 
-#ifdef ENABLE_SFL3S_0600F
-
 bool      startFlowMeasurement();
 bool      stopFlowMeasurement();
 
+Sample    readSample();         // µL·min⁻¹, SampleQ bits
 float     readFlow();           // µL·min⁻¹
 float     getTempC();           // °C
 uint16_t  getLastFlags();       // status bits
 float     getRawFlow();         // µL·min⁻¹ (raw)
 
-#endif /* ENABLE_SFL3S_0600F */
+const Hal::SensorHealth& sensorHealth();
+
+/* HAL back-end (driver state is module-local, so this is empty) */
+class Slf3sSensor : public Hal::FlowSensor<Slf3sSensor> {
+    friend class Hal::FlowSensor<Slf3sSensor>;
+    bool     beginImpl() { return startFlowMeasurement(); }
+    Sample   readImpl()  { return readSample(); }
+    float    tempCImpl() { return getTempC(); }
+    const Hal::SensorHealth& healthImpl() { return sensorHealth(); }
+};
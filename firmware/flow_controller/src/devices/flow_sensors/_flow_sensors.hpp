@@ -1,4 +1,5 @@
 #pragma once
 
 #include "SLF3S-0600F/SFL3S-0600F.hpp"
+#include "replay/replay_sensor.hpp"
 // Add more includes if you implement anything in `custom/`
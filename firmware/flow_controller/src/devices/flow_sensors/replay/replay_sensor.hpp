@@ -0,0 +1,51 @@
+#pragma once
+/*  replay_sensor.hpp – plays back a recorded flow trace
+ *  ----------------------------------------------------
+ *  One sample per read(), i.e. per control tick, stamped with the
+ *  time of the read.  Feed it the r_flw column of an srl_rec export
+ *  (and the matching SF06 status words, if any) to re-run the
+ *  controller against a captured run.  Past the end it wraps
+ *  (loop = true) or holds the last sample.
+ */
+
+#include <stddef.h>
+#include "../../hal/hal.hpp"
+#include "../../../include/_include.hpp"   // State::nowUs
+
+class ReplaySensor : public Hal::FlowSensor<ReplaySensor> {
+public:
+    void attach(const float* flow_uLmin, const uint16_t* flags,
+                size_t n, bool loop = true)
+    {
+        mFlow = flow_uLmin; mFlags = flags; mN = n; mLoop = loop; mPos = 0;
+    }
+
+    size_t position() const { return mPos; }
+    bool   done()     const { return !mLoop && mPos >= mN; }
+
+private:
+    friend class Hal::FlowSensor<ReplaySensor>;
+
+    bool  beginImpl() { mPos = 0; return mN != 0; }
+
+    Sample readImpl()
+    {
+        Sample s;
+        s.t_us = State::nowUs();
+        if (!mN) { s.q = SampleQ::OFFLINE; return s; }
+
+        if (mPos >= mN) {
+            if (mLoop) mPos = 0;
+            else       s.q |= SampleQ::HELD;
+        }
+        if (mPos < mN) mCur = mPos++;
+        s.value = mFlow[mCur];
+        if (mFlags) s.q |= SampleQ::fromSlf(mFlags[mCur]);
+        return s;
+    }
+
+    const float*    mFlow  = nullptr;
+    const uint16_t* mFlags = nullptr;
+    size_t          mN     = 0, mPos = 0, mCur = 0;
+    bool            mLoop  = true;
+};
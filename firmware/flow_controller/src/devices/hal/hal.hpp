@@ -0,0 +1,115 @@
+#pragma once
+/*  hal.hpp – static-dispatch hardware abstraction
+ *  ----------------------------------------------
+ *  A back-end derives from FlowSensor<Self> / Pump<Self> and supplies
+ *  the private *Impl() hooks (declare the base a friend).  Calls are
+ *  resolved at compile time – no vtable, and the one-line wrappers
+ *  inline away on the MCU.  MinCtrl<Cfg> and the egc path take these
+ *  types as template arguments, so real hardware, the simulator and
+ *  a replay source run the same controller code.
+ *
+ *  TOP is the nominal wrap value: one STEP period is 2·(TOP+1) ticks
+ *  of STEP_CLK_HZ.  TOP = 0 means stop.  Back-ends that only take a
+ *  TOP (the simulator) use this fixed model; setSps() lets a back-end
+ *  synthesise the period itself (RP2040: 8.4 divider + TOP, see
+ *  step_timing.hpp, and µ-step mode) and returns the rate it will
+ *  actually run.  Rates and the odometer stay in the finest µ-step.
+ */
+
+#include <math.h>                   // NAN
+#include <stdint.h>
+#include <type_traits>
+#include "../../core/sample/sample.hpp"
+#include "step_timing.hpp"
+
+namespace Hal {
+
+/* ─── rate model behind TOP ─── */
+constexpr double STEP_CLK_HZ = 125'000'000.0 / 8.0;   // SYSCLK / CLKDIV
+
+inline uint16_t spsToTop(double sps)
+{
+    double top = STEP_CLK_HZ / (2.0 * sps) - 1.0;
+    if (top < 1)     top = 1;
+    if (top > 65535) top = 65535;
+    return static_cast<uint16_t>(top);
+}
+
+inline float topToSps(uint16_t top)
+{
+    return top ? STEP_CLK_HZ / (2.0 * (top + 1)) : 0.0f;
+}
+
+/* ─── sensor link health (counters since boot) ─── */
+enum class SensorState : uint8_t { OK, RECOVERING, FAILED };
+
+struct SensorHealth {
+    SensorState state       = SensorState::OK;
+    uint8_t     consecutive = 0;    // current run of read errors
+    uint32_t    readErrors  = 0;
+    uint32_t    staleEvents = 0;    // no good sample within the timeout
+    uint32_t    busClears   = 0;    // recovery attempts
+    uint32_t    restarts    = 0;    // successful re-starts
+};
+
+/* ─── flow sensor: one timestamped, quality-flagged sample per call ─── */
+template <class D>
+class FlowSensor {
+public:
+    bool   begin() { return self().beginImpl(); }
+    Sample read()  { return self().readImpl(); }       // compensated, µL/min
+    float  tempC() { return self().tempCImpl(); }      // °C, NaN if none
+
+    const SensorHealth& health() { return self().healthImpl(); }
+
+protected:
+    FlowSensor() = default;
+
+    /* default for back-ends that cannot fail */
+    const SensorHealth& healthImpl()
+    { static const SensorHealth none; return none; }
+
+    /* default for back-ends without a temperature channel */
+    float tempCImpl() { return NAN; }
+
+private:
+    D& self() { return static_cast<D&>(*this); }
+};
+
+/* ─── step pump: period command + step odometer ─── */
+template <class D>
+class Pump {
+public:
+    void     begin()              { self().beginImpl(); }
+    void     setTop(uint16_t top) { self().setTopImpl(top); }
+    float    setSps(float sps)    { return self().setSpsImpl(sps); }   // → achieved
+    void     stop()               { setTop(0); }
+
+    uint32_t stepCount()          { return self().stepCountImpl(); }
+    void     stopAt(uint32_t n)   { self().stopAtImpl(n); }
+    void     clearStop()          { self().clearStopImpl(); }
+    bool     stopReached()        { return self().stopReachedImpl(); }
+    uint8_t  microstep()          { return self().microstepImpl(); }   // 0 = fixed
+
+protected:
+    Pump() = default;
+
+    /* default: the rate is only as fine as TOP, at a fixed µ-step */
+    float setSpsImpl(float sps)
+    {
+        uint16_t top = sps > 0 ? spsToTop(sps) : 0;
+        setTop(top);
+        return topToSps(top);
+    }
+    uint8_t microstepImpl()       { return 0; }
+
+private:
+    D& self() { return static_cast<D&>(*this); }
+};
+
+template <class T>
+constexpr bool isFlowSensor = std::is_base_of<FlowSensor<T>, T>::value;
+template <class T>
+constexpr bool isPump       = std::is_base_of<Pump<T>, T>::value;
+
+}   // namespace Hal
@@ -0,0 +1,66 @@
+#pragma once
+/*  step_timing.hpp – RP2040 PWM period synthesis for STEP
+ *  ------------------------------------------------------
+ *  Edge-aligned slice: one STEP period is (DIV16 / 16)·(TOP + 1)
+ *  cycles of SYS_CLK_HZ, DIV16 = 16·INT + FRAC being the 8.4 clock
+ *  divider (1.0 … 255.9375).  Divider and TOP are chosen together:
+ *  the smallest divider that fits the period into 16 bits, and the
+ *  next TIMING_SEARCH dividers, are each tried with the nearest TOP,
+ *  and the pair closest to the requested period wins.  Wherever the
+ *  divider is above 1 the period keeps > 61 000 counts, and the
+ *  lowest rate drops to SYS_CLK_HZ / (255.9375 · 65536) ≈ 7.5 /s.
+ *
+ *  No Arduino dependencies, so tools/step_timing_table.cpp builds
+ *  it on the host.
+ */
+
+#include <math.h>
+#include <stdint.h>
+
+namespace Hal {
+
+constexpr double   SYS_CLK_HZ    = 125'000'000.0;
+constexpr uint16_t DIV16_MIN     = 16;          // 1.0
+constexpr uint16_t DIV16_MAX     = 4095;        // 255 + 15/16
+constexpr uint32_t TOP1_MAX      = 65536;       // TOP + 1
+constexpr uint8_t  TIMING_SEARCH = 16;          // dividers tried per rate
+
+struct StepTiming {
+    uint16_t top   = 0;                         // 0 ⇒ stop
+    uint16_t div16 = DIV16_MIN;
+};
+
+inline bool operator==(StepTiming a, StepTiming b)
+{ return a.top == b.top && a.div16 == b.div16; }
+
+inline double timingToSps(StepTiming t)
+{
+    return t.top ? SYS_CLK_HZ * 16.0 / (double(t.div16) * (t.top + 1.0)) : 0.0;
+}
+
+inline StepTiming spsToTiming(double sps)
+{
+    StepTiming best;
+    if (!(sps > 0.0)) return best;
+
+    const double p16 = 16.0 * SYS_CLK_HZ / sps;         // period · 16, in cycles
+    double d0 = ceil(p16 / TOP1_MAX);
+    if (d0 < DIV16_MIN) d0 = DIV16_MIN;
+    if (d0 > DIV16_MAX) d0 = DIV16_MAX;
+
+    double bestErr = 1e30;
+    for (uint32_t d = uint32_t(d0); d <= DIV16_MAX && d < d0 + TIMING_SEARCH; ++d) {
+        double t1 = floor(p16 / d + 0.5);
+        if (t1 < 2)        t1 = 2;
+        if (t1 > TOP1_MAX) t1 = TOP1_MAX;
+        double err = fabs(d * t1 - p16);
+        if (err < bestErr) {
+            bestErr    = err;
+            best.top   = uint16_t(t1 - 1);
+            best.div16 = uint16_t(d);
+        }
+    }
+    return best;
+}
+
+}   // namespace Hal
@@ -1,17 +1,36 @@
 #include "drv8825.hpp"
 
-#ifdef ENABLE_DRV8825
 using namespace PumpDrv;
 
-/* 1/32 µ-step pattern (M0 tied LOW on carrier) */
-struct Mode { bool m0, m1, m2; };
-static constexpr Mode MODE_1_32{ false, true, true };
+/* µ-step patterns reachable with M0 tied LOW on the carrier, finest first */
+struct Mode { bool m1, m2; uint8_t div; };
+static constexpr Mode MODES[] = {
+    { true,  true,  32 },               // 1/32
+    { false, true,  16 },               // 1/16
+    { true,  false,  4 },               // 1/4
+    { false, false,  1 },               // full step
+};
+static constexpr uint8_t N_MODES    = sizeof(MODES) / sizeof(MODES[0]);
+static constexpr uint8_t PHASE_MASK = MICROSTEP_DIV - 1;
 
 /* ───── internal state ───── */
 namespace {
     float  tgtSps = 0.0f;
     float  curSps = 0.0f;
-    constexpr float PULSES_PER_REV = 200.0f * MICROSTEP_DIV;
+
+    /* odometer – written from the step ISR / service */
+    volatile uint32_t odo      = 0;
+    volatile uint32_t stopCnt  = 0;
+    volatile bool     stopArm  = false;
+    volatile bool     stopHit  = false;
+
+    /* µ-step mode – odometer weight per pulse and the pending change */
+    volatile uint8_t  modeIdx  = 0;          // MODES[] in force
+    volatile uint8_t  stepW    = 1;          // 1/32-steps per STEP pulse
+    volatile uint8_t  phase    = 0;          // 1/32-steps past a full step
+    volatile int8_t   pendIdx  = -1;         // mode waiting for a boundary
+    Hal::StepTiming   pendTiming;            // its period
+    volatile bool     pendLatched = false;   // period loaded for the next edge
 
 #if !(defined(ARDUINO_ARCH_RP2040) || defined(__AVR__))
     /* bit-bang backend variables */
@@ -27,46 +46,181 @@ static void setMicrostepPins(const Mode& m)
     digitalWrite(PIN_M1, m.m1);
     digitalWrite(PIN_M2, m.m2);
 }
+static void applyMode(uint8_t i)
+{
+    setMicrostepPins(MODES[i]);
+    stepW       = MICROSTEP_DIV / MODES[i].div;
+    modeIdx     = i;
+    pendIdx     = -1;
+    pendLatched = false;
+}
 static void driverEnable(bool en)
 {
     digitalWrite(PIN_EN   , en ? LOW  : HIGH);
     digitalWrite(PIN_SLEEP, en ? HIGH : LOW );
+    if (en) return;
+    phase = 0;                              // sleep homes the indexer
+    if (pendIdx >= 0) applyMode(pendIdx);
+}
+
+/* finest mode whose STEP period keeps STEP_COUNTS_MIN system clocks
+   and whose pulse rate the driver can take; going finer than the
+   current mode needs the hysteresis margin                         */
+static uint8_t pickMode(float sps)
+{
+    uint8_t cur = pendIdx >= 0 ? pendIdx : modeIdx;
+    for (uint8_t i = 0; i < N_MODES; ++i) {
+        float pulses = sps * MODES[i].div / MICROSTEP_DIV;
+        float counts = Hal::SYS_CLK_HZ / pulses;
+        float need   = i < cur ? STEP_COUNTS_MIN * STEP_MODE_HYST : STEP_COUNTS_MIN;
+        if (counts >= need && pulses <= MAX_SPS) return i;
+    }
+    return N_MODES - 1;
+}
+
+static inline Hal::StepTiming modeTiming(float sps, uint8_t i)
+{
+    return Hal::spsToTiming(sps * MODES[i].div / MICROSTEP_DIV);
 }
 
 /* ─────────────────────────── RP2040 PWM slice backend ─────────────────────────── */
 #if defined(ARDUINO_ARCH_RP2040)
 #include "hardware/pwm.h"
+#include "hardware/irq.h"
+#include "hardware/gpio.h"
+
+/* The wrap ISR stays enabled while the totalizer erases or programs
+   flash (XIP off), so it and everything it calls are in RAM and touch
+   only RAM and registers: no digitalWrite, no MODES[] (.rodata).    */
 static uint slice;
+static volatile bool running = false;
+static Hal::StepTiming cur;                 // last loaded into the slice
+static uint8_t  pendW  = 1;                 // stepW of pendIdx …
+static bool     pendM1 = true, pendM2 = true;   // … and its M1 / M2
 
-static inline void hwSetTop(uint16_t top)
+/* The divider is not double-buffered like wrap and level: a new one
+   is armed and written by the ISR of the wrap at which the new TOP
+   goes live, i.e. the next wrap, or the one after if a wrap is
+   already waiting to be serviced.                                 */
+static volatile uint16_t divArm   = Hal::DIV16_MIN;
+static volatile uint8_t  divWraps = 0;      // wrap ISRs until divArm applies
+
+static __force_inline void setDiv(uint16_t div16)
+{
+    pwm_set_clkdiv_int_frac(slice, div16 >> 4, div16 & 0xF);
+}
+
+/* caller holds interrupts off (or is the wrap ISR) */
+static __force_inline void loadTiming(Hal::StepTiming t, bool wrapPending)
+{
+    if (t.top == cur.top && t.div16 == cur.div16) return;
+    pwm_set_wrap(slice, t.top);
+    pwm_set_chan_level(slice, PWM_CHAN_A, t.top / 2);   // 50 % duty
+    if (t.div16 != cur.div16) {
+        divArm   = t.div16;
+        divWraps = wrapPending ? 2 : 1;
+    }
+    cur = t;
+}
+
+/* Runs after each STEP edge while a mode change waits.  Timing
+   written here loads at the next wrap, so the period goes in one
+   pulse before the boundary and the pins right after it.        */
+static __force_inline void modeEdge()
+{
+    if (pendLatched) {                      // boundary edge: applyMode(), from RAM
+        gpio_put(PIN_M1, pendM1);
+        gpio_put(PIN_M2, pendM2);
+        stepW       = pendW;
+        modeIdx     = pendIdx;
+        pendIdx     = -1;
+        pendLatched = false;
+    } else if (((phase + stepW) & PHASE_MASK) == 0) {
+        loadTiming(pendTiming, false);
+        pendLatched = true;
+    }
+}
+
+/* one wrap == one rising edge on STEP (see counter pre-load below) */
+static void __not_in_flash_func(onPwmWrap)()
+{
+    pwm_clear_irq(slice);
+    if (divWraps && --divWraps == 0) setDiv(divArm);
+    uint32_t n = odo + stepW;
+    odo   = n;
+    phase = (phase + stepW) & PHASE_MASK;
+    if (stopArm && static_cast<int32_t>(n - stopCnt) >= 0) {
+        pwm_set_enabled(slice, false);
+        running = false;
+        stopArm = false;
+        stopHit = true;
+        return;
+    }
+    if (pendIdx >= 0) modeEdge();
+}
+
+static inline bool wrapPending()
+{
+    return pwm_get_irq_status_mask() & (1u << slice);
+}
+
+/* caller holds interrupts off */
+static inline void hwSetTiming(Hal::StepTiming t)
 {
-    if (top == 0) {                      // stop pulses, tri-state STEP
+    if (t.top == 0 || stopHit) {         // stop pulses, tri-state STEP
         pwm_set_enabled(slice, false);
+        running   = false;
+        divWraps  = 0;
         return;
     }
-    pwm_set_wrap(slice, top);
-    pwm_set_chan_level(slice, PWM_CHAN_A, top / 2);   // 50 % duty
-    pwm_set_enabled(slice, true);                      // always ensure enabled
+    if (running) { loadTiming(t, wrapPending()); return; }
+
+    /* idle: everything applies at once; start with STEP low so the
+       first edge lands on a wrap                                   */
+    divWraps = 0;
+    setDiv(t.div16);
+    pwm_set_wrap(slice, t.top);
+    pwm_set_chan_level(slice, PWM_CHAN_A, t.top / 2);
+    pwm_set_counter(slice, t.top / 2);
+    cur     = t;
+    running = true;
+    pwm_set_enabled(slice, true);
+}
+
+/* nominal TOP (Hal::STEP_CLK_HZ model) → the same rate, re-synthesised */
+static inline void hwSetTop(uint16_t top)
+{
+    hwSetTiming(Hal::spsToTiming(top ? Hal::topToSps(top) : 0.0));
 }
 
 static inline void hwSetFreq(uint32_t sps)             /* legacy helper */
 {
-    if (!sps) { hwSetTop(0); return; }
-    uint32_t clk = clock_get_hz(clk_sys);
-    uint32_t top = clk / sps;
-    if (top) top -= 1; else top = 1;
-    hwSetTop(static_cast<uint16_t>(top));
+    noInterrupts();
+    hwSetTiming(Hal::spsToTiming(sps));
+    interrupts();
 }
 
 /* ─────────────────────────── AVR 16-bit Timer1 backend ─────────────────────────── */
 #elif defined(__AVR__)
+ISR(TIMER1_COMPA_vect)                          // two toggles per step
+{
+    static bool level = false;
+    level = !level;
+    if (!level) return;
+    uint32_t n = ++odo;
+    if (stopArm && static_cast<int32_t>(n - stopCnt) >= 0) {
+        TCCR1B = 0; stopArm = false; stopHit = true;
+    }
+}
+
 static inline void hwSetTop(uint16_t top)
 {
-    if (top == 0) { TCCR1B = 0; return; }
+    if (top == 0 || stopHit) { TCCR1B = 0; return; }
     pinMode(PIN_STEP, OUTPUT);
     TCCR1A = _BV(COM1A0);                       // toggle OC1A on compare
     TCCR1B = _BV(WGM12) | _BV(CS10);            // CTC, presc=1
     OCR1A  = top;
+    TIMSK1 |= _BV(OCIE1A);                      // odometer
 }
 static inline void hwSetFreq(uint32_t sps)
 {
@@ -78,9 +232,10 @@ static inline void hwSetFreq(uint32_t sps)
 
 /* ─────────────────────────── bit-bang fallback backend ─────────────────────────── */
 #else
-static inline void hwSetTop(uint16_t top)
+static inline void hwSetTop(uint16_t top)      /* same rate model as the slice */
 {
-    halfPeriodUs = top ? (top + 1) / 2 : 0;
+    halfPeriodUs = (top && !stopHit)
+                 ? static_cast<uint32_t>(500'000.0f / Hal::topToSps(top)) : 0;
 }
 static inline void hwSetFreq(uint32_t sps)
 {
@@ -94,6 +249,11 @@ static inline void hwService()
         lastToggleUs = now;
         stepLevel = !stepLevel;
         digitalWrite(PIN_STEP, stepLevel);
+        if (!stepLevel) return;
+        uint32_t n = ++odo;
+        if (stopArm && static_cast<int32_t>(n - stopCnt) >= 0) {
+            halfPeriodUs = 0; stopArm = false; stopHit = true;
+        }
     }
 }
 #endif  /* backend selection */
@@ -113,7 +273,7 @@ void PumpDrv::initPump()
 #endif
     pinMode(PIN_M1, OUTPUT); pinMode(PIN_M2, OUTPUT);
 
-    setMicrostepPins(MODE_1_32);
+    applyMode(0);                           // 1/32 until the rate says otherwise
     digitalWrite(PIN_DIR, HIGH);
     driverEnable(false);
 
@@ -121,7 +281,14 @@ void PumpDrv::initPump()
     slice = pwm_gpio_to_slice_num(PIN_STEP);
     pwm_config cfg = pwm_get_default_config();
     pwm_init(slice, &cfg, false);
+    pwm_set_phase_correct(slice, false);    // edge-aligned, see step_timing.hpp
+    setDiv(cur.div16);
     gpio_set_function(PIN_STEP, GPIO_FUNC_PWM);
+
+    pwm_clear_irq(slice);
+    pwm_set_irq_enabled(slice, true);
+    irq_set_exclusive_handler(PWM_IRQ_WRAP, onPwmWrap);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
 #endif
 }
 
@@ -154,8 +321,68 @@ void PumpDrv::pumpService()
 /* ---- period-driven API (preferred on RP2040) ---- */
 void PumpDrv::setTop(uint16_t top)
 {
-    if (top == 0) driverEnable(false);
-    else          driverEnable(true);
+    setSps(top ? Hal::topToSps(top) : 0.0f);
+}
+
+float PumpDrv::setSps(float sps)
+{
+    if (!(sps > 0.0f) || stopHit) {
+        driverEnable(false);
+#if defined(ARDUINO_ARCH_RP2040)
+        noInterrupts(); hwSetTop(0); interrupts();
+#else
+        hwSetTop(0);
+#endif
+        return 0.0f;
+    }
+    driverEnable(true);
+
+#if defined(ARDUINO_ARCH_RP2040)
+    uint8_t want = pickMode(sps);
+    Hal::StepTiming t = modeTiming(sps, want);
+    noInterrupts();
+    if (want == modeIdx) {
+        pendIdx = -1; pendLatched = false;          // cancel a change in flight
+        hwSetTiming(t);
+    } else if (!running && phase == 0) {
+        applyMode(want);                            // at rest on a full step
+        hwSetTiming(t);
+    } else {
+        pendIdx    = want;
+        pendTiming = t;
+        pendW      = MICROSTEP_DIV / MODES[want].div;
+        pendM1     = MODES[want].m1;
+        pendM2     = MODES[want].m2;
+        if (pendLatched) loadTiming(t, wrapPending());    // boundary is the next edge
+        else             hwSetTiming(modeTiming(sps, modeIdx));   // old mode, new rate
+    }
+    interrupts();
+    /* the rate the slice will run once the new mode is in */
+    return Hal::timingToSps(t) * MICROSTEP_DIV / MODES[want].div;
+#else
+    uint16_t top = Hal::spsToTop(sps);              // fixed 1/32
     hwSetTop(top);
+    return Hal::topToSps(top);
+#endif
 }
-#endif  /* ENABLE_DRV8825 */
+
+uint8_t PumpDrv::microstepDiv() { return MODES[modeIdx].div; }
+
+/* ---- step odometer ---- */
+uint32_t PumpDrv::stepCount() { return odo; }
+
+void PumpDrv::stopAt(uint32_t count)
+{
+    noInterrupts();
+    stopCnt = count; stopHit = false; stopArm = true;
+    interrupts();
+}
+
+void PumpDrv::clearStop()
+{
+    noInterrupts();
+    stopArm = false; stopHit = false;
+    interrupts();
+}
+
+bool PumpDrv::stopReached() { return stopHit; }
@@ -1,10 +1,24 @@
 #pragma once
-/* drv8825.hpp – 1/32-µstep pump driver for RP2040, AVR, fallback */
+/* drv8825.hpp – µstep pump driver for RP2040, AVR, fallback
+ *
+ * Rates and the odometer are in 1/MICROSTEP_DIV steps whatever the
+ * mode.  On RP2040 each period is synthesised from the 8.4 clock
+ * divider and TOP together (Hal::spsToTiming), and the driver picks
+ * the finest mode (M0 is strapped LOW: 1/32, 1/16, 1/4, full) whose
+ * STEP period still spans STEP_COUNTS_MIN system clocks, so rate
+ * resolution stays ≈ 1/STEP_COUNTS_MIN or better across the range.
+ * Each STEP pulse then counts 32/div on the odometer, and setSps()
+ * returns the rate actually synthesised.  A mode change is made at a
+ * full-step boundary: the new period is latched one pulse ahead and
+ * M1/M2 switch right after the edge that lands on the boundary, so
+ * the first coarse step already runs at the new period.  Boundaries are counted from the indexer's home
+ * state, which sleep restores (nRESET tied to nSLEEP on the carrier).
+ * AVR and bit-bang back-ends stay at 1/32.                         */
 
-#include "../../../include/_include.hpp"   // pins, feature flags
+#include "../../../include/_include.hpp"   // pins, constants
 #include <Arduino.h>
+#include "../../hal/hal.hpp"
 
-#ifdef ENABLE_DRV8825
 namespace PumpDrv {
 
 /* ---------- tuning constants -------------------------------- */
@@ -13,6 +27,24 @@ constexpr uint32_t MAX_FULL_SPS        = 1200;      // full-steps / s
 constexpr uint32_t MAX_SPS             = MAX_FULL_SPS * MICROSTEP_DIV;
 constexpr uint32_t MIN_SPS             = 20;
 constexpr uint32_t ACCEL_SPS_PER_CYCLE = 0;         // 0 = no ramp
+constexpr uint32_t STEP_COUNTS_MIN     = 32768;     // coarser mode below this period, SYSCLKs
+constexpr float    STEP_MODE_HYST      = 1.25f;     // finer mode only above COUNTS_MIN·this
+static_assert(MICROSTEP_DIV == MICROSTEP, "odometer unit is config.hpp's µ-step");
+
+/* Flow at which a mode gives way to the next coarser one: a 1/div mode
+   emits sps·div/32 pulses, so its period drops under STEP_COUNTS_MIN
+   clocks above SYS_CLK_HZ/STEP_COUNTS_MIN · 32/div 1/32-steps/s.  With
+   VPR = 42 µL over PULSES_PER_REV:
+     1/32 → 1/16   above ≈  1502 µL/min, back below ≈ 1202 (hysteresis)
+     1/16 → 1/4    above ≈  3004 µL/min   beyond RATE_MAX_UL_MIN
+     1/4  → full   above ≈ 12016 µL/min   beyond RATE_MAX_UL_MIN
+   so only the 1/32 ↔ 1/16 pair switches in the product range.      */
+constexpr double modeExitUlMin(uint32_t div)
+{
+    return Hal::SYS_CLK_HZ / STEP_COUNTS_MIN * MICROSTEP_DIV / div * UL_PER_STEP * 60.0;
+}
+static_assert(modeExitUlMin(32) < RATE_MAX_UL_MIN,
+              "1/32 → 1/16 never engages in the rate range: retune STEP_COUNTS_MIN");
 
 /* ---------- public API -------------------------------------- */
 void  initPump();
@@ -25,6 +57,26 @@ float currentSPS();
 
 /* period-driven interface (new, finer resolution) */
 void  setTop(uint16_t top);             // 0 ⇒ stop / disable output
+float setSps(float sps);                // 1/32-steps / s → rate achieved
+uint8_t microstepDiv();                 // mode in force: 1, 4, 16, 32
+
+/* step odometer (STEP rising edges since initPump) */
+uint32_t stepCount();
+void     stopAt(uint32_t count);        // hard stop when odometer hits count
+void     clearStop();
+bool     stopReached();                 // latched until clearStop()
 
 } // namespace PumpDrv
-#endif
+
+/* HAL back-end (driver state is module-local, so this is empty) */
+class Drv8825Pump : public Hal::Pump<Drv8825Pump> {
+    friend class Hal::Pump<Drv8825Pump>;
+    void     beginImpl()               { PumpDrv::initPump(); }
+    void     setTopImpl(uint16_t top)  { PumpDrv::setTop(top); }
+    float    setSpsImpl(float sps)     { return PumpDrv::setSps(sps); }
+    uint8_t  microstepImpl()           { return PumpDrv::microstepDiv(); }
+    uint32_t stepCountImpl()           { return PumpDrv::stepCount(); }
+    void     stopAtImpl(uint32_t n)    { PumpDrv::stopAt(n); }
+    void     clearStopImpl()           { PumpDrv::clearStop(); }
+    bool     stopReachedImpl()         { return PumpDrv::stopReached(); }
+};
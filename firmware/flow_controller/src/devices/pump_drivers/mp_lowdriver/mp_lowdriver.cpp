@@ -8,7 +8,6 @@
  #include <Wire.h>
  #include <Arduino.h>
 
-  #ifdef ENABLE_MP_LOWDRIVER
  
  // Single default delay (milliseconds)
  static const uint16_t default_delay = 40;
@@ -182,5 +181,4 @@
  
    delay(default_delay);
  }
- 
-  #endif // ENABLE_MP_LOWDRIVER
\ No newline at end of file
+ 
\ No newline at end of file
@@ -0,0 +1,99 @@
+/*  sim.cpp – plant model for SimPump / SimSensor
+ *  All rates in µL·min⁻¹; volume per step from UL_PER_STEP.
+ */
+
+#include "sim.hpp"
+#include <math.h>
+
+/* ───── plant state ───── */
+namespace {
+    Sim::Params prm;
+
+    uint16_t top       = 0;
+    double   steps     = 0.0;        // fractional odometer
+    uint32_t stopCnt   = 0;
+    bool     stopArm   = false;
+    bool     stopHit   = false;
+
+    float    q         = 0.0f;       // lagged flow (µL/min)
+    uint64_t lastUs    = 0;
+    uint64_t airEndUs  = 0;
+    uint64_t dropEndUs = 0;
+    Sample   held;                   // sensor output during a dropout
+    uint32_t rng       = 0x2545F491u;
+
+    float noise()                   // xorshift32 → [-1, 1)
+    {
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        return static_cast<float>(rng) * (2.0f / 4294967296.0f) - 1.0f;
+    }
+
+    void advance()
+    {
+        uint64_t now = State::nowUs();
+        float dt = (now - lastUs) * 1e-6f;
+        lastUs = now;
+        if (dt <= 0.0f) return;
+
+        float sps = (top && !stopHit) ? Hal::topToSps(top) : 0.0f;
+        steps += sps * dt;
+        if (stopArm && steps >= stopCnt) {          // hard stop, like the ISR
+            steps   = stopCnt;
+            top     = 0;
+            stopArm = false;
+            stopHit = true;
+            sps     = 0.0f;
+        }
+
+        float qCmd = sps * UL_PER_STEP * 60.0f * prm.gain + prm.leak_uLmin;
+        q += (qCmd - q) * (1.0f - expf(-dt / prm.tau_s));
+    }
+}
+
+Sim::Params& Sim::params() { return prm; }
+
+void Sim::reset()
+{
+    top = 0; steps = 0.0; q = 0.0f;
+    stopArm = stopHit = false;
+    lastUs = State::nowUs(); airEndUs = dropEndUs = 0;
+    held = Sample{};
+}
+
+void Sim::injectAir(uint32_t ms)     { airEndUs  = State::nowUs() + ms * 1000ULL; }
+void Sim::injectDropout(uint32_t ms) { dropEndUs = State::nowUs() + ms * 1000ULL; }
+
+void Sim::setTop(uint16_t t)
+{
+    advance();
+    top = stopHit ? 0 : t;
+}
+
+uint32_t Sim::stepCount()   { advance(); return static_cast<uint32_t>(steps); }
+
+void Sim::stopAt(uint32_t n)
+{
+    advance();
+    stopCnt = n; stopHit = false; stopArm = true;
+}
+
+void Sim::clearStop()       { stopArm = false; stopHit = false; }
+bool Sim::stopReached()     { advance(); return stopHit; }
+
+Sample Sim::sample()
+{
+    advance();
+    uint64_t now = State::nowUs();
+    if (now < dropEndUs) {
+        Sample h = held;
+        h.q = SampleQ::OFFLINE | SampleQ::HELD;
+        return h;
+    }
+
+    Sample s;
+    s.value = q + prm.noise_uLmin * noise();
+    s.t_us  = now;
+    s.q     = now < airEndUs ? SampleQ::AIR : 0;
+    if (s.good()) held = s;
+    return s;
+}
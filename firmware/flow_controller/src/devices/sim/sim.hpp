@@ -0,0 +1,54 @@
+#pragma once
+/*  sim.hpp – host-free plant model behind the HAL
+ *  ----------------------------------------------
+ *  SimPump integrates the commanded TOP into a step odometer (with
+ *  the same stopAt() semantics as the DRV8825 back-end); SimSensor
+ *  sees that delivery through a first-order lag plus noise.  Both
+ *  share one plant, advanced lazily on every call from State::nowUs().
+ *  Select with Build::Simulated to run the full loop on a bare board.
+ */
+
+#include "../../include/_include.hpp"
+#include "../hal/hal.hpp"
+
+namespace Sim {
+
+struct Params {
+    float gain        = 1.0f;       // delivered / nominal volume per step
+    float tau_s       = 0.8f;       // tubing compliance lag
+    float noise_uLmin = 2.0f;       // ± uniform sensor noise
+    float leak_uLmin  = 0.0f;       // siphon / free flow past the rollers
+    float temp_C      = 23.0f;      // reported by SimSensor::tempC()
+};
+
+Params& params();
+void    reset();                    // zero odometer, flow and clock
+void    injectAir(uint32_t ms);     // raise SLF_FLAG_AIR_IN_LINE for ms
+void    injectDropout(uint32_t ms); // sensor link down (OFFLINE|HELD) for ms
+
+/* plant access for the HAL back-ends */
+void     setTop(uint16_t top);
+uint32_t stepCount();
+void     stopAt(uint32_t n);
+void     clearStop();
+bool     stopReached();
+Sample   sample();                  // µL/min incl. noise; held in a dropout
+
+}   // namespace Sim
+
+class SimPump : public Hal::Pump<SimPump> {
+    friend class Hal::Pump<SimPump>;
+    void     beginImpl()               { Sim::reset(); }
+    void     setTopImpl(uint16_t top)  { Sim::setTop(top); }
+    uint32_t stepCountImpl()           { return Sim::stepCount(); }
+    void     stopAtImpl(uint32_t n)    { Sim::stopAt(n); }
+    void     clearStopImpl()           { Sim::clearStop(); }
+    bool     stopReachedImpl()         { return Sim::stopReached(); }
+};
+
+class SimSensor : public Hal::FlowSensor<SimSensor> {
+    friend class Hal::FlowSensor<SimSensor>;
+    bool     beginImpl() { return true; }
+    Sample   readImpl()  { return Sim::sample(); }
+    float    tempCImpl() { return Sim::params().temp_C; }
+};
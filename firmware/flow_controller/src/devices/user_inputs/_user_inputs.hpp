@@ -1,4 +1,6 @@
 #pragma once
 
+#include "btn_events/btn_events.hpp"
 #include "buttons_two/buttons_two.hpp"
 #include "buttons_six/buttons_six.hpp"
+#include "null_input/null_input.hpp"
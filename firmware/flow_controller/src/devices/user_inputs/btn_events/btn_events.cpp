@@ -0,0 +1,121 @@
+/*
+ *  btn_events.cpp — GPIO edge ISRs + timer debounce → event queue
+ *  ---------------------------------------------------------------
+ *  Producer: the debounce alarm (RP2040) or the edge ISR (other
+ *  cores); consumer: pop() from the loop.  Single producer context,
+ *  so the ring needs no lock beyond ordered index writes.
+ */
+
+#include "btn_events.hpp"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include "pico/time.h"
+#endif
+
+namespace {
+    uint8_t           pinOf[BtnEvt::MAX_BTNS];
+    uint8_t           nBtns   = 0;
+
+    volatile uint8_t  stable  = 0;              // debounced level mask
+    volatile uint32_t tEdge[BtnEvt::MAX_BTNS];  // first edge of the burst
+    volatile bool     armed[BtnEvt::MAX_BTNS];  // settle alarm outstanding
+
+    BtnEvt::Event     ring[BtnEvt::QUEUE_LEN];
+    volatile uint8_t  head    = 0, tail = 0;
+    volatile uint32_t lost    = 0;
+
+    void push(uint8_t id, bool down, uint32_t t)
+    {
+        uint8_t h = head;
+        if (static_cast<uint8_t>(h - tail) >= BtnEvt::QUEUE_LEN) { ++lost; return; }
+        ring[h & (BtnEvt::QUEUE_LEN - 1)] = {id, down, t};
+        head = h + 1;                           // publish after the write
+    }
+
+    /* compare the settled pin with the last report; queue on change */
+    void settle(uint8_t id)
+    {
+        bool    down = digitalRead(pinOf[id]) == LOW;
+        uint8_t bit  = 1u << id;
+        if (down == static_cast<bool>(stable & bit)) return;   // bounce only
+        stable ^= bit;
+        push(id, down, tEdge[id]);
+    }
+
+#if defined(ARDUINO_ARCH_RP2040)
+    int64_t onSettle(alarm_id_t, void* user)
+    {
+        uint8_t id = static_cast<uint8_t>(reinterpret_cast<uintptr_t>(user));
+        armed[id] = false;                      // edges from here re-arm
+        settle(id);
+        return 0;                               // one-shot
+    }
+
+    /* edges during the window only cost this test */
+    template <uint8_t ID>
+    void onEdge()
+    {
+        if (armed[ID]) return;
+        armed[ID] = true;
+        tEdge[ID] = micros();
+        add_alarm_in_us(BtnEvt::DEBOUNCE_US, onSettle,
+                        reinterpret_cast<void*>(static_cast<uintptr_t>(ID)), true);
+    }
+#else
+    /* no one-shot alarm: accept the leading edge, ignore the burst;
+       pop() re-syncs a level that changed inside the lock-out   */
+    template <uint8_t ID>
+    void onEdge()
+    {
+        uint32_t now = micros();
+        if (armed[ID] && now - tEdge[ID] < BtnEvt::DEBOUNCE_US) return;
+        armed[ID] = true;
+        tEdge[ID] = now;
+        settle(ID);
+    }
+#endif
+
+    using Isr = void (*)();
+    constexpr Isr ISR[BtnEvt::MAX_BTNS] = {
+        onEdge<0>, onEdge<1>, onEdge<2>, onEdge<3>, onEdge<4>, onEdge<5>
+    };
+}
+
+bool BtnEvt::attach(uint8_t id, uint8_t pin)
+{
+    if (id >= MAX_BTNS) return false;
+    pinMode(pin, INPUT_PULLUP);
+    pinOf[id] = pin;
+    armed[id] = false;
+    if (digitalRead(pin) == LOW) stable |= 1u << id;   // held at boot: no event
+    else                         stable &= ~(1u << id);
+    if (id >= nBtns) nBtns = id + 1;
+    attachInterrupt(digitalPinToInterrupt(pin), ISR[id], CHANGE);
+    return true;
+}
+
+bool BtnEvt::pending() { return head != tail; }
+
+bool BtnEvt::pop(Event& e)
+{
+#if !defined(ARDUINO_ARCH_RP2040)
+    /* a level that settled inside the lock-out produced no edge */
+    uint32_t now = micros();
+    for (uint8_t id = 0; id < nBtns; ++id) {
+        if (!armed[id] || now - tEdge[id] < DEBOUNCE_US) continue;
+        noInterrupts();
+        armed[id] = false;
+        tEdge[id] = now;
+        settle(id);
+        interrupts();
+    }
+#endif
+    uint8_t t = tail;
+    if (t == head) return false;
+    e    = ring[t & (QUEUE_LEN - 1)];
+    tail = t + 1;
+    return true;
+}
+
+uint8_t  BtnEvt::heldMask() { return stable; }
+uint32_t BtnEvt::dropped()  { return lost; }
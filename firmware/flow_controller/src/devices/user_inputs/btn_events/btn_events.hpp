@@ -0,0 +1,34 @@
+#pragma once
+/*  btn_events.hpp – interrupt-driven button capture
+ *  ------------------------------------------------
+ *  Each attached pin (active-low, internal pull-up) raises a GPIO
+ *  interrupt on either edge.  The first edge of a bounce burst is
+ *  timestamped and a one-shot hardware alarm samples the pin
+ *  DEBOUNCE_US later; if the settled level differs from the last
+ *  reported one, an Event carrying the *first-edge* time is queued.
+ *  Nothing runs while the buttons are idle, and press/hold timing
+ *  comes from the timestamps, not from when the loop gets around
+ *  to pop().
+ */
+
+#include <Arduino.h>
+
+namespace BtnEvt {
+
+constexpr uint8_t  MAX_BTNS    = 6;
+constexpr uint8_t  QUEUE_LEN   = 16;           // power of two
+constexpr uint32_t DEBOUNCE_US = 20'000;
+
+struct Event {
+    uint8_t  id;          // as passed to attach()
+    bool     down;        // true = pressed (pin LOW)
+    uint32_t t_us;        // micros() at the first edge of the burst
+};
+
+bool     attach(uint8_t id, uint8_t pin);      // id < MAX_BTNS
+bool     pending();                            // queue not empty
+bool     pop(Event& e);                        // oldest first
+uint8_t  heldMask();                           // debounced, bit id = down
+uint32_t dropped();                            // events lost to a full queue
+
+}   // namespace BtnEvt
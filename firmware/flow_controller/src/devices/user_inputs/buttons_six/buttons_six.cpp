@@ -4,11 +4,11 @@
  */
 
  #include "buttons_six.hpp"
+ #include "../btn_events/btn_events.hpp"
  #include "../../../include/_include.hpp"  // FLOW_SP_MIN, FLOW_SP_MAX, FLOW_STEP_SIZE
  #include <Arduino.h>
  #include <EEPROM.h>
  
-#ifdef ENABLE_BUTTONS_SIX
 
  // Pin assignments
  static const int PIN_ONOFF       = D6;
@@ -18,13 +18,9 @@
  static const int PIN_ERROR_DOWN  = D7;
  static const int PIN_MODE_TOGGLE = D10;
  
- // Previous states for edge detection
- static int oldState_onoff       = HIGH;
- static int oldState_flowUp      = HIGH;
- static int oldState_flowDown    = HIGH;
- static int oldState_errorUp     = HIGH;
- static int oldState_errorDown   = HIGH;
- static int oldState_modeToggle  = HIGH;
+ // Button ids in the BtnEvt queue
+ enum : uint8_t { BTN_ONOFF, BTN_FLOW_UP, BTN_FLOW_DOWN,
+                  BTN_ERROR_UP, BTN_ERROR_DOWN, BTN_MODE_TOGGLE };
  
  // System variables
  static bool  systemOn          = false;
@@ -37,17 +33,6 @@
  static const int EEPROM_ADDR_ERROR    = 0;
  static const int EEPROM_ADDR_SETPOINT = 4;
  
- /*
-  * Function: checkFallingEdge
-  * Brief: Returns true if the given pin transitions from HIGH to LOW.
-  */
- static bool checkFallingEdge(int pin, int &oldState) {
-   int newState = digitalRead(pin);
-   bool triggered = (newState == LOW && oldState == HIGH);
-   oldState = newState;
-   return triggered;
- }
- 
  /*
   * Function: loadFromEEPROM
   * Brief: Loads stored error and setpoint values if they are valid.
@@ -86,76 +71,75 @@
   * Note: EEPROM.begin(...) must be called before this function.
   */
  void initButtons() {
-   pinMode(PIN_ONOFF,       INPUT_PULLUP);
-   pinMode(PIN_FLOW_UP,     INPUT_PULLUP);
-   pinMode(PIN_FLOW_DOWN,   INPUT_PULLUP);
-   pinMode(PIN_ERROR_UP,    INPUT_PULLUP);
-   pinMode(PIN_ERROR_DOWN,  INPUT_PULLUP);
-   pinMode(PIN_MODE_TOGGLE, INPUT_PULLUP);
+   BtnEvt::attach(BTN_ONOFF,       PIN_ONOFF);
+   BtnEvt::attach(BTN_FLOW_UP,     PIN_FLOW_UP);
+   BtnEvt::attach(BTN_FLOW_DOWN,   PIN_FLOW_DOWN);
+   BtnEvt::attach(BTN_ERROR_UP,    PIN_ERROR_UP);
+   BtnEvt::attach(BTN_ERROR_DOWN,  PIN_ERROR_DOWN);
+   BtnEvt::attach(BTN_MODE_TOGGLE, PIN_MODE_TOGGLE);
  
    loadFromEEPROM();
- 
-   oldState_onoff      = digitalRead(PIN_ONOFF);
-   oldState_flowUp     = digitalRead(PIN_FLOW_UP);
-   oldState_flowDown   = digitalRead(PIN_FLOW_DOWN);
-   oldState_errorUp    = digitalRead(PIN_ERROR_UP);
-   oldState_errorDown  = digitalRead(PIN_ERROR_DOWN);
-   oldState_modeToggle = digitalRead(PIN_MODE_TOGGLE);
  }
  
  /*
   * Function: updateButtons
-  * Brief: Reads button inputs each loop to update systemOn, setpoint, error%, 
+  * Brief: Drains queued presses to update systemOn, setpoint, error%,
   *        and mode toggle state. Saves changes to EEPROM if values changed.
+  *        Presses made while the loop was busy are applied, not lost.
   */
  void updateButtons() {
    bool changed = false;
    modeTogglePressed = false; // Reset each iteration
  
-   // On/Off toggle
-   if (checkFallingEdge(PIN_ONOFF, oldState_onoff)) {
-     systemOn = !systemOn;
-   }
+   BtnEvt::Event e;
+   while (BtnEvt::pop(e)) {
+     if (!e.down) continue;     // act on the press edge only
  
-   // Flow Up
-   if (checkFallingEdge(PIN_FLOW_UP, oldState_flowUp)) {
-     flowSetpointValue += FLOW_STEP_SIZE;
-     if (flowSetpointValue > FLOW_SP_MAX) {
-       flowSetpointValue = FLOW_SP_MAX;
+     // On/Off toggle
+     if (e.id == BTN_ONOFF) {
+       systemOn = !systemOn;
      }
-     changed = true;
-   }
  
-   // Flow Down
-   if (checkFallingEdge(PIN_FLOW_DOWN, oldState_flowDown)) {
-     flowSetpointValue -= FLOW_STEP_SIZE;
-     if (flowSetpointValue < FLOW_SP_MIN) {
-       flowSetpointValue = FLOW_SP_MIN;
+     // Flow Up
+     if (e.id == BTN_FLOW_UP) {
+       flowSetpointValue += FLOW_STEP_SIZE;
+       if (flowSetpointValue > FLOW_SP_MAX) {
+         flowSetpointValue = FLOW_SP_MAX;
+       }
+       changed = true;
      }
-     changed = true;
-   }
  
-   // Error% Up
-   if (checkFallingEdge(PIN_ERROR_UP, oldState_errorUp)) {
-     errorPercentValue += 1.0f;
-     if (errorPercentValue > 50.0f) {
-       errorPercentValue = 50.0f;
+     // Flow Down
+     if (e.id == BTN_FLOW_DOWN) {
+       flowSetpointValue -= FLOW_STEP_SIZE;
+       if (flowSetpointValue < FLOW_SP_MIN) {
+         flowSetpointValue = FLOW_SP_MIN;
+       }
+       changed = true;
      }
-     changed = true;
-   }
  
-   // Error% Down
-   if (checkFallingEdge(PIN_ERROR_DOWN, oldState_errorDown)) {
-     errorPercentValue -= 1.0f;
-     if (errorPercentValue < -50.0f) {
-       errorPercentValue = -50.0f;
+     // Error% Up
+     if (e.id == BTN_ERROR_UP) {
+       errorPercentValue += 1.0f;
+       if (errorPercentValue > 50.0f) {
+         errorPercentValue = 50.0f;
+       }
+       changed = true;
      }
-     changed = true;
-   }
  
-   // Mode toggle
-   if (checkFallingEdge(PIN_MODE_TOGGLE, oldState_modeToggle)) {
-     modeTogglePressed = true;
+     // Error% Down
+     if (e.id == BTN_ERROR_DOWN) {
+       errorPercentValue -= 1.0f;
+       if (errorPercentValue < -50.0f) {
+         errorPercentValue = -50.0f;
+       }
+       changed = true;
+     }
+ 
+     // Mode toggle
+     if (e.id == BTN_MODE_TOGGLE) {
+       modeTogglePressed = true;
+     }
    }
  
    // Save to EEPROM if values changed
@@ -193,5 +177,3 @@
    return modeTogglePressed;
  }
  
-
-  #endif // ENABLE_BUTTONS_SIX
\ No newline at end of file
@@ -2,21 +2,13 @@
 #include "../../../include/_include.hpp"   // access g_state
 #include "../../../min_main.hpp"           // PIN defs, RGB helpers
 
-#ifdef ENABLE_BUTTONS_TWO
 
 /* externs defined in min_ctrl.cpp */
 extern volatile bool     gCalibRunning;
 extern volatile uint32_t gCalibStart;
 
-/* quick RGB flasher ----------------------------------------------------- */
-namespace RGB {
-inline void flash(LEDColour a, LEDColour b, uint16_t d = 150)
-{
-    setColour(a); delay(d);
-    setColour(b); delay(d);
-    setColour(State::isPumpEnabled() ? LED_GREEN : LED_RED);
-}
-}
+/* confirmation flash: one blue/green blink, then back to the status colour */
+constexpr RGB::Pattern CONFIRM = RGB::blink(LED_BLUE, LED_GREEN, 300, 1);
 
 /* internal helpers ------------------------------------------------------ */
 void ButtonsTwo::updateLED()
@@ -29,12 +21,12 @@ void ButtonsTwo::updateLED()
 /* ───── begin() ───── */
 bool ButtonsTwo::begin()
 {
-    pinMode(PIN_BTN_UP, INPUT_PULLUP);
-    pinMode(PIN_BTN_DN, INPUT_PULLUP);
+    BtnEvt::attach(UP, PIN_BTN_UP);
+    BtnEvt::attach(DN, PIN_BTN_DN);
     RGB::begin();
 
-    mNumberVal   = static_cast<int32_t>(State::read().setpoint);
-    mLetterIdx   = static_cast<int16_t>(State::read().calScalar);
+    mMask        = BtnEvt::heldMask();
+    mSuppress    = mMask != 0;              // held through reset: ignore
     mPumpEnabled = State::isPumpEnabled();
     updateLED();
     return true;
@@ -46,114 +38,136 @@ extern void startCalibrationAndStore();
 /* ───── poll() ───── */
 void ButtonsTwo::poll()
 {
-    /* lock-out during calibration */
-    if (gCalibRunning) return;
-
     mPageEdge = false;
 
-    bool upLow  = digitalRead(PIN_BTN_UP) == LOW;
-    bool dnLow  = digitalRead(PIN_BTN_DN) == LOW;
-    uint8_t mask = (upLow ? 1 : 0) | (dnLow ? 2 : 0);
-    uint32_t now = millis();
-
-    /* ===== dual-press logic ===== */
-    if (mask == 3) {                          // both held
-        if (!mDualActive) {
-            mDualActive  = true;
-            mDualStart   = now;
-            mPumpLatched = false;
-        }
-        if (!mPumpLatched && (now - mDualStart) >= PUMP_HOLD_MS) {
-            mPumpLatched = true;
-
-            if (mMode == Mode::CALIB && !gCalibRunning) {
-                /* ---- launch calibration ---- */
-                gCalibRunning        = true;
-                gCalibStart          = millis();
-                extern volatile SystemState g_state;
-                g_state.calibrating  = true;
-
-                startCalibrationAndStore();   // blocks
-
-                gCalibRunning        = false;
-                g_state.calibrating  = false;
-
-                /* -------- return to first page & refresh UI -------- */
-                mMode     = Mode::SETPOINT;
-                mPageEdge = true;             // ← forces redraw
-                RGB::flash(LED_BLUE, LED_GREEN);
-
-                /* ---------- reset button-state latches ------------- */
-                mDualActive  = false;
-                mPumpLatched = false;
-                mLastMask    = 0;
-            } else {                          // toggle pump
-                mPumpEnabled = !mPumpEnabled;
-                State::setPumpEnabled(mPumpEnabled);
-                updateLED();
-                Serial.print(F("[BTN] Pump "));
-                Serial.println(mPumpEnabled ? F("ENABLED")
-                                            : F("DISABLED"));
-            }
-        }
-    } else {                                  // released
-        if (mDualActive) {
-            uint32_t held = now - mDualStart;
-            if (!mPumpLatched &&
-                held >= PAGE_HOLD_MS && held < PUMP_HOLD_MS)
-            {   /* cycle pages */
-                switch (mMode) {
-                    case Mode::SETPOINT: mMode = Mode::MEASURE;     break;
-                    case Mode::MEASURE:  mMode = Mode::CALSCALAR;   break;
-                    case Mode::CALSCALAR:mMode = Mode::CALIB;       break;
-                    default:             mMode = Mode::SETPOINT;
-                }
-                mPageEdge = true;
+    /* idle: no events queued and nothing held → nothing to time */
+    if (!mMask && !BtnEvt::pending()) return;
+
+    BtnEvt::Event e;
+    while (BtnEvt::pop(e)) {
+        /* lock-out during calibration: drain, keep the level only */
+        if (gCalibRunning) { mMask = BtnEvt::heldMask(); mSuppress = true; continue; }
+        expire(e.t_us);                     // holds due before this edge
+        onEvent(e);
+    }
+    if (mMask && !gCalibRunning) expire(micros());
+}
+
+/* ───── one debounced edge ───── */
+void ButtonsTwo::onEvent(const BtnEvt::Event& e)
+{
+    uint8_t bit  = 1u << e.id;
+    uint8_t prev = mMask;
+    mMask = e.down ? (mMask | bit) : (mMask & ~bit);
+
+    if (e.down && e.id == UP) { mUpDownAt = e.t_us; mUpFired = false; }
+
+    /* ===== dual-press ===== */
+    if (mMask == 3 && !mDualActive) {
+        mDualActive  = true;
+        mDualStart   = e.t_us;
+        mPumpLatched = false;
+        mSuppress    = true;
+    }
+    if (mDualActive && mMask != 3) {        // first release ends the chord
+        uint32_t held = e.t_us - mDualStart;
+        if (!mPumpLatched && held >= PAGE_HOLD_US && held < PUMP_HOLD_US) {
+            /* cycle pages */
+            switch (mMode) {
+                case Mode::SETPOINT: mMode = Mode::MEASURE;     break;
+                case Mode::MEASURE:  mMode = Mode::CALSCALAR;   break;
+                case Mode::CALSCALAR:mMode = Mode::CALIB;       break;
+                default:             mMode = Mode::SETPOINT;
             }
-            mDualActive = false;
+            mPageEdge = true;
         }
+        mDualActive = false;
     }
 
-    /* ===== single-button short presses ===== */
-    static uint32_t lastDeb = 0;
-    if (mask != mLastMask && now - lastDeb > DEBOUNCE_MS) {
+    /* ===== single-button release ===== */
+    if (!e.down && prev == bit && mMask == 0) {
+        bool longHeld = e.id == UP && mUpFired;
+        if (!mSuppress && !longHeld) shortPress(e.id);
+    }
+    if (mMask == 0) mSuppress = false;
+}
 
-        if (mLastMask == 1 && mask == 0) {          // UP release
-            if (mMode == Mode::SETPOINT && mNumberVal <= 65000 - 10) {
-                mNumberVal += 10; announce("Set", mNumberVal);
-            }
-            if (mMode == Mode::CALSCALAR && mLetterIdx < 50) {
-                ++mLetterIdx; announce("Cal%", mLetterIdx);
-            }
-        }
-        if (mLastMask == 2 && mask == 0) {          // DN release
-            if (mMode == Mode::SETPOINT && mNumberVal >= 10) {
-                mNumberVal -= 10; announce("Set", mNumberVal);
-            }
-            if (mMode == Mode::CALSCALAR && mLetterIdx > -50) {
-                --mLetterIdx; announce("Cal%", mLetterIdx);
-            }
+/* ───── holds, judged at time t (an edge stamp or now) ───── */
+void ButtonsTwo::expire(uint32_t t)
+{
+    if (mDualActive && !mPumpLatched && t - mDualStart >= PUMP_HOLD_US) {
+        mPumpLatched = true;
+        dualHold();
+    }
+
+    /* ===== UP long-hold systemOn toggle (once per press) ===== */
+    if (mMask == 1 && !mUpFired && t - mUpDownAt >= SYS_HOLD_US) {
+        mUpFired = true;
+        bool sys = !State::isSystemOn();
+        State::setSystemOn(sys);
+        Serial.print(F("[BTN] System "));
+        Serial.println(sys ? F("ON") : F("OFF"));
+    }
+}
+
+void ButtonsTwo::dualHold()
+{
+    if (mMode == Mode::CALIB && !gCalibRunning) {
+        /* ---- launch calibration ---- */
+        gCalibRunning        = true;
+        gCalibStart          = millis();
+        extern volatile SystemState g_state;
+        g_state.calibrating  = true;
+
+        startCalibrationAndStore();   // blocks
+
+        gCalibRunning        = false;
+        g_state.calibrating  = false;
+
+        /* -------- return to first page & refresh UI -------- */
+        mMode     = Mode::SETPOINT;
+        mPageEdge = true;             // ← forces redraw
+        RGB::play(CONFIRM);
+
+        /* ---------- reset button-state latches ------------- */
+        mDualActive = false;
+        mMask       = BtnEvt::heldMask();
+        mSuppress   = true;
+    } else {                          // toggle pump
+        /* re-sync: dose / serial may have changed the flag */
+        mPumpEnabled = !State::isPumpEnabled();
+        State::setPumpEnabled(mPumpEnabled);
+        updateLED();
+        Serial.print(F("[BTN] Pump "));
+        Serial.println(mPumpEnabled ? F("ENABLED")
+                                    : F("DISABLED"));
+    }
+}
+
+/* ───── short press: edit the live value, or continue a program ───── */
+void ButtonsTwo::shortPress(uint8_t id)
+{
+    /* any release continues a program WAIT step */
+    if (Program::state() == Program::Run::WAITING) {
+        Program::signal();
+        Serial.println(F("[BTN] Program continue"));
+        return;
+    }
+
+    int8_t dir = (id == UP) ? 1 : -1;
+    /* edits start from the live state: serial may have changed it */
+    if (mMode == Mode::SETPOINT) {
+        float sp = State::read().setpoint + dir * 10.0f;
+        if (sp >= 0.0f && sp <= 65000.0f) {
+            State::setSetpoint(sp); announce("Set", sp);
         }
-        lastDeb = now;
     }
-    mLastMask = mask;
-
-    /* ===== UP long-hold systemOn toggle ===== */
-    static uint32_t upHold = 0;
-    if (upLow && !dnLow) {
-        if (!upHold) upHold = now;
-        else if (now - upHold >= 1000) {
-            bool sys = !State::isSystemOn();
-            State::setSystemOn(sys);
-            Serial.print(F("[BTN] System "));
-            Serial.println(sys ? F("ON") : F("OFF"));
-            upHold = 0;
+    if (mMode == Mode::CALSCALAR) {
+        float cal = State::getCalScalar() + dir;
+        if (cal >= -50.0f && cal <= 50.0f) {
+            State::setCalScalar(cal); announce("Cal%", cal);
         }
-    } else upHold = 0;
-
-    /* ===== push edits to global state ===== */
-    State::setSetpoint (static_cast<float>(mNumberVal));
-    State::setCalScalar(static_cast<float>(mLetterIdx));
+    }
 }
 
 /* helper --------------------------------------------------------------- */
@@ -166,4 +180,3 @@ void ButtonsTwo::announce(const char* tag, float v) const
     else               Serial.println(v, 0);
 }
 
-#endif /* ENABLE_BUTTONS_TWO */
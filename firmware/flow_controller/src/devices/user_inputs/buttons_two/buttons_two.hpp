@@ -6,43 +6,53 @@
  *  Dual-press ≥5 s                    :  pump toggle (any page except CAL)  OR
  *                                        run calibration (CAL page)
  *  Long-press  UP ≥1 s                :  systemOn toggle
+ *
+ *  Presses arrive as timestamped BtnEvt events, so every hold is
+ *  measured edge to edge and holds that matured while the loop was
+ *  busy are still honoured when their events are drained.  Releases
+ *  that end a chord or a long-hold do not count as short presses.
  */
 
 #include <Arduino.h>
 #include "../../../include/_include.hpp"
 #include "../../_devices.hpp"
-
-#ifdef ENABLE_BUTTONS_TWO
+#include "../btn_events/btn_events.hpp"
 
 class ButtonsTwo {
 public:
     bool begin();
-    void poll();
+    void poll();                    // drains BtnEvt; free when idle
     bool pageChanged() const { return mPageEdge; }
 
 private:
     enum class Mode : uint8_t { SETPOINT, MEASURE, CALSCALAR, CALIB };
 
-    /* timings (ms) */
-    static constexpr uint32_t PAGE_HOLD_MS = 500;
-    static constexpr uint32_t PUMP_HOLD_MS = 5000;
-    static constexpr uint32_t DEBOUNCE_MS  = 20;
+    /* button ids in BtnEvt / bits in mMask */
+    static constexpr uint8_t UP = 0, DN = 1;
 
-    /* dual-press bookkeeping */
-    uint32_t mDualStart{0};
-    bool     mDualActive{false};
+    /* timings (µs, measured between edge timestamps) */
+    static constexpr uint32_t PAGE_HOLD_US = 500'000;
+    static constexpr uint32_t PUMP_HOLD_US = 5'000'000;
+    static constexpr uint32_t SYS_HOLD_US  = 1'000'000;
+
+    /* debounced level and press bookkeeping */
+    uint8_t  mMask       {0};
+    uint32_t mUpDownAt   {0};
+    uint32_t mDualStart  {0};
+    bool     mDualActive {false};
     bool     mPumpLatched{false};
+    bool     mUpFired    {false};   // UP long-hold already acted
+    bool     mSuppress   {false};   // swallow releases after a chord
 
     /* editable state */
     Mode     mMode        {Mode::SETPOINT};
-    int32_t  mNumberVal   {0};    // µL/min
-    int16_t  mLetterIdx   {0};    // cal-scalar %
-    uint8_t  mLastMask    {0};
     bool     mPageEdge    {false};
     bool     mPumpEnabled {false};
 
+    void onEvent(const BtnEvt::Event& e);
+    void expire(uint32_t t_us);     // fire holds that matured by t_us
+    void shortPress(uint8_t id);
+    void dualHold();
     void announce(const char* tag, float v) const;
     void updateLED();
 };
-
-#endif /* ENABLE_BUTTONS_TWO */
@@ -0,0 +1,11 @@
+#pragma once
+/*  null_input.hpp – headless stand-in for ButtonsTwo
+ *  No pins are touched; the set-point comes from serial only.
+ */
+
+class NullInput {
+public:
+    bool begin()             { return true; }
+    void poll()              {}
+    bool pageChanged() const { return false; }
+};
@@ -42,6 +42,32 @@ static const float SLF_SCALE_FACTOR_FLOW = 10000.0f;
 static const float SLF_SCALE_FACTOR_TEMP = 200.0f;
 static const float SLF_RUN_DURATION      = 604800.0f;   // s (7 days)
 
+/* SF06-LF status word: bit 0 = air-in-line, bit 1 = high flow */
+constexpr uint16_t SLF_FLAG_AIR_IN_LINE = 0x0001;
+constexpr uint16_t SLF_FLAG_HIGH_FLOW   = 0x0002;
+
+// ---------------------------------------------------------------------------
+// Flow-sensor health & I²C recovery
+// ---------------------------------------------------------------------------
+constexpr uint8_t  SENS_ERR_LIMIT      = 3;      // consecutive read errors → recover
+constexpr uint32_t SENS_STALE_MS       = 50;     // no good sample for this long → recover
+constexpr uint32_t SENS_RESTART_GAP_MS = 5;      // stop → start settling time
+constexpr uint32_t SENS_BACKOFF_MIN_MS = 50;     // first retry delay, doubles per failure
+constexpr uint32_t SENS_BACKOFF_MAX_MS = 2000;
+constexpr uint8_t  SENS_FAIL_AFTER     = 5;      // failed recoveries before "FAILED"
+
+constexpr uint16_t SAMPLE_WINDOW_TICKS = 100;    // good-sample fraction window (1 s)
+
+/* outage fallback: false = hold last pump command,
+                    true  = run open-loop on the set-point        */
+constexpr bool     SENS_FALLBACK_FEEDFORWARD = false;
+
+// ---------------------------------------------------------------------------
+// Bubble (air-in-line) handling
+// ---------------------------------------------------------------------------
+constexpr bool     BUBBLE_HOLD_ENABLE = true;   // freeze PID / volume on flag
+constexpr uint32_t BUBBLE_RELEASE_MS  = 200;    // stay latched after flag clears
+
 // ---------------------------------------------------------------------------
 // Flow / Error Ranges
 // ---------------------------------------------------------------------------
@@ -84,6 +110,18 @@ static const float FILTER_B2_GUESS       = 3.0f;
 static const float PID_ANTIWINDUP_GAIN    = 0.1f;
 static const float PID_DERIV_FILTER_ALPHA = 0.8f;
 
+// ---------------------------------------------------------------------------
+// Flow-loop PID (FlowPid in MinCtrl) – µL/min in, µL/min out, dt explicit
+// ---------------------------------------------------------------------------
+constexpr float    FLOW_PID_KP          = 1.0f;
+constexpr float    FLOW_PID_KI          = 0.30f;  // 1 / s
+constexpr float    FLOW_PID_KD          = 0.0f;   // s
+constexpr float    FLOW_PID_OUT_MIN     = 50.0f;  // µL/min
+constexpr float    FLOW_PID_OUT_MAX     = 1500.0f;
+constexpr float    PID_SP_WEIGHT        = 1.0f;   // b: P on the model reference (0: measurement only)
+constexpr float    PID_REF_TAU_S        = 0.25f;  // reference model ≈ tube compliance
+constexpr float    PID_TRACK_S          = 1.0f;   // back-calculation time constant
+
 // ---------------------------------------------------------------------------
 // Timing
 // ---------------------------------------------------------------------------
@@ -93,6 +131,17 @@ static const unsigned long MAIN_LOOP_DELAY_MS =
     (unsigned long)((FLUID_TIME_CONSTANT / LOOP_FREQ_FACTOR) * 1000.0f);
 
 constexpr uint32_t LOOP_INTERVAL_MS = 10;
+constexpr uint16_t TELEM_DEFAULT_EVERY = 25;   // ticks → 250 ms at boot
+
+// ---------------------------------------------------------------------------
+// EEPROM (flash-emulated) map
+// ---------------------------------------------------------------------------
+constexpr int    EE_ADDR_STATE   = 0;       // PersistBlob  (system_state.cpp)
+constexpr int    EE_ADDR_PROGRAM = 64;      // ProgBlob     (sp_program.cpp)
+constexpr int    EE_ADDR_TOTAL   = 320;     // totalizer ring (non-RP2040 fallback)
+constexpr int    EE_ADDR_TCOMP   = 512;     // TcBlob       (temp_comp.cpp)
+constexpr int    EE_ADDR_CAL     = 768;     // CalBlob      (cal_curve.cpp)
+constexpr size_t EE_SIZE         = 1024;
 
 // ---------------------------------------------------------------------------
 // 24 V rail monitor
@@ -101,6 +150,27 @@ constexpr uint8_t PIN_DETECT_24V   = A1;
 constexpr float   R_SENSE_TOP      = 30'000.0f;
 constexpr float   R_SENSE_BOTTOM   = 7'500.0f;
 
+// ---------------------------------------------------------------------------
+// Power-loss-safe totalizer
+// Worst-case loss after a reset = TOTAL_CKPT_UL or TOTAL_CKPT_MS of flow,
+// whichever comes first (one checkpoint is staged on whichever limit trips),
+// plus the length of a dose: no flash is written while one runs.
+// RP2040: the journal occupies the top TOTAL_FLASH_SECTORS × 4 KB of the
+// FS partition (select a Flash Size with FS ≥ 16 KB); otherwise it falls
+// back to TOTAL_EE_SLOTS records at EE_ADDR_TOTAL, checkpointed only while
+// the pump is stopped – the loss bound is then one whole run.
+// ---------------------------------------------------------------------------
+constexpr uint32_t TOTAL_CKPT_MS        = 60'000; // checkpoint at least this often
+constexpr float    TOTAL_CKPT_UL        = 1000.0f;// …or after this much volume
+constexpr uint8_t  TOTAL_FLASH_SECTORS  = 4;      // 4 × 256 records per cycle
+constexpr uint8_t  TOTAL_EE_SLOTS       = 8;      // 8 × 16 B
+/* PIN_DETECT_24V is GP27 (= D1 = PIN_DIR) on the XIAO map: leave off
+   unless the divider is wired to a free ADC pin.  The divider clips
+   at 3.3 V × 5 = 16.5 V, so a drop is only seen below that.        */
+constexpr bool     RAIL_SENSE_ENABLE    = false;
+constexpr float    RAIL_DROP_V          = 15.0f;  // below → checkpoint now
+constexpr float    RAIL_OK_V            = 16.0f;  // re-arm above
+
 // ---------------------------------------------------------------------------
 // Valve & LED GPIO map
 // ---------------------------------------------------------------------------
@@ -130,10 +200,141 @@ constexpr uint8_t PIN_PUMP_STEP = 7;
 // ---------------------------------------------------------------------------
 constexpr uint8_t  ROLLERS     = 6;
 constexpr uint8_t  VPR         = 42;      // ★ µL per rev (was 13)
-constexpr uint8_t  TPS         = 2;       // gearbox teeth / rev
 constexpr uint16_t SPR         = 200;     // full steps / rev
 constexpr uint16_t MICROSTEP   = 32;      // ★ 1/32-step
 
+/* Step rates, the odometer and every volume-per-step figure are in real
+   1/32-step STEP pulses.  VPR was calibrated on the baseline slice, which
+   ran at divider 1 edge-aligned, i.e. 16× its "125 MHz / 8, 2·(TOP+1)"
+   model; the old SPR·TPS = 400 steps/rev only matched the pulses through
+   that hidden factor.                                                  */
+constexpr uint32_t PULSES_PER_REV = uint32_t(SPR) * MICROSTEP;   // 6400
+constexpr float    UL_PER_STEP    = static_cast<float>(VPR) / PULSES_PER_REV;
+
+// ---------------------------------------------------------------------------
+// Exact-volume dosing
+// ---------------------------------------------------------------------------
+constexpr float    DOSE_BRAKE_S         = 2.0f;   // Q ≤ V_rem / τ on approach
+constexpr float    DOSE_MIN_RATE_UL_MIN = 50.0f;  // floor so the run completes
+constexpr uint32_t DOSE_SETTLE_MS       = 2'000;  // sensor tail after stop
+
+// ---------------------------------------------------------------------------
+// Occlusion / stall / free-flow detection  (steps delivered vs. measured,
+// steps delivered vs. commanded)
+// Window = OCCL_BLOCKS × OCCL_BLOCK_TICKS; worst-case detection time is
+// (OCCL_BLOCKS + OCCL_HOLD_BLOCKS) blocks = 3.0 s at 100 Hz, plus the
+// OCCL_SETTLE_BLOCKS blanking (3.0 s, so 6.0 s) when the fault follows a
+// commanded rate step or stop – free flow after the pump is switched off.
+// ---------------------------------------------------------------------------
+constexpr uint8_t  OCCL_BLOCK_TICKS     = 25;     // 250 ms per block
+constexpr uint8_t  OCCL_BLOCKS          = 8;      // 2 s sliding window
+constexpr uint8_t  OCCL_HOLD_BLOCKS     = 4;      // verdict must repeat (1 s)
+constexpr uint8_t  OCCL_SETTLE_BLOCKS   = 12;     // blank after a rate step (3 s)
+constexpr float    OCCL_STEP_FRAC       = 0.25f;  // block-to-block change = "step"
+constexpr float    OCCL_MIN_GOOD        = 0.80f;  // good-sample share to judge
+constexpr float    OCCL_MIN_EXP_UL_MIN  = 50.0f;  // below: pump counts as stopped
+constexpr float    OCCL_RATIO           = 0.60f;  // meas / exp below → occluded
+constexpr float    STALL_RATIO          = 0.10f;  // odo / command below → stalled
+constexpr float    FREEFLOW_RATIO       = 1.50f;  // meas / exp above → free flow
+constexpr float    FREEFLOW_UL_MIN      = 30.0f;  // flow with pump stopped
+constexpr bool     OCCL_STOP_PUMP       = false;  // stop on OCCLUDED / STALLED
+
+// ---------------------------------------------------------------------------
+// Temperature compensation (SLF3S temperature channel)
+// Two gains on a uniform grid, linearly interpolated:
+//   sensor  – true / indicated flow        (applied to every sample)
+//   rate    – delivered / nominal µL/step  (applied in the rate → TOP map)
+// ---------------------------------------------------------------------------
+constexpr float    TC_T_MIN_C           = 10.0f;  // first grid point
+constexpr float    TC_STEP_C            = 2.5f;   // grid spacing
+constexpr uint8_t  TC_POINTS            = 13;     // 10 … 40 °C
+constexpr float    TC_LEARN_RATE        = 0.5f;   // share of the error taken per run
+constexpr float    TC_LEARN_MIN_UL      = 200.0f; // smallest dose that teaches
+constexpr float    TC_GAIN_MIN          = 0.7f;   // learned gains are clamped
+constexpr float    TC_GAIN_MAX          = 1.3f;
+
+// ---------------------------------------------------------------------------
+// Multi-point sensor calibration
+// Up to CAL_MAX_PAIRS (indicated, true) flow pairs, fitted with a monotone
+// cubic and sampled onto a uniform grid of true/indicated gains over
+// 0 … (CAL_GRID_POINTS-1)·CAL_GRID_STEP_UL.  Beyond the pairs the end
+// gains hold.
+// ---------------------------------------------------------------------------
+constexpr uint8_t  CAL_MAX_PAIRS        = 16;
+constexpr uint8_t  CAL_GRID_POINTS      = 33;
+constexpr float    CAL_GRID_STEP_UL     = 64.0f;  // 0 … 2048 µL/min
+constexpr float    CAL_MERGE_UL         = 10.0f;  // closer pairs replace each other
+constexpr float    CAL_GAIN_MIN         = 0.5f;   // plausible true / indicated
+constexpr float    CAL_GAIN_MAX         = 1.5f;
+
+// ---------------------------------------------------------------------------
+// Gravimetric calibration (balance on UART1, MT-SICS "SI" polling)
+// Point k's sensor window is [settle end, +GCAL_WINDOW_MS]; its balance
+// window is the same span shifted by GCAL_BAL_LAG_MS, so it closes while
+// point k+1 is still settling.  Total ≈ n·(SETTLE + WINDOW) + LAG.
+// ---------------------------------------------------------------------------
+constexpr float    FLUID_DENSITY_G_ML   = 0.97f;  // volume ↔ mass
+constexpr uint8_t  GCAL_DEFAULT_POINTS  = 5;      // RATE_MIN … RATE_MAX
+constexpr uint32_t GCAL_SETTLE_MS       = 20'000; // after each set-point change
+constexpr uint32_t GCAL_WINDOW_MS       = 60'000; // averaging window per point
+constexpr uint32_t GCAL_BAL_LAG_MS      = 5'000;  // balance / drip delay
+constexpr uint32_t GCAL_BAL_TIMEOUT_MS  = 3'000;  // no reading → abort
+constexpr uint16_t GCAL_MIN_READINGS    = 20;     // per balance window
+constexpr uint32_t BAL_BAUD             = 9600;
+constexpr uint16_t BAL_POLL_MS          = 100;    // one "SI" per 100 ms
+constexpr uint16_t BAL_REPLY_MS         = 500;    // unanswered → resend
+static_assert(GCAL_BAL_LAG_MS < GCAL_SETTLE_MS,
+              "balance window must close inside the next point's settle");
+
+// ---------------------------------------------------------------------------
+// Roller-synchronous ripple compensation
+// One revolution = PULSES_PER_REV odometer steps, split into RIPPLE_BINS
+// angle bins.  Each tick's flow is booked to the bin the
+// rotor was in RIPPLE_LAG_TICKS earlier; a finished, steady revolution has
+// the tube lag (RIPPLE_TUBE_TAU_S) undone and moves the learned delivery
+// gains RIPPLE_LEARN_RATE of the way – by the residual while modulating.
+// ---------------------------------------------------------------------------
+constexpr uint32_t RIPPLE_STEPS_PER_REV = PULSES_PER_REV;
+constexpr uint8_t  RIPPLE_BINS          = 48;     // 8 per roller
+constexpr uint8_t  RIPPLE_LAG_TICKS     = 2;      // sensor + tubing delay
+constexpr float    RIPPLE_LEARN_RATE    = 0.2f;   // per accepted revolution
+constexpr float    RIPPLE_STEADY_FRAC   = 0.05f;  // base-rate spread per rev
+constexpr uint8_t  RIPPLE_MIN_REVS      = 3;      // learned before it modulates
+constexpr float    RIPPLE_GAIN_MIN      = 0.7f;   // delivery gain clamp
+constexpr float    RIPPLE_GAIN_MAX      = 1.3f;
+constexpr float    RIPPLE_TUBE_TAU_S    = 0.25f;  // = KF_TAU_S, undone per revolution
+static_assert(RIPPLE_BINS % ROLLERS == 0, "whole bins per roller");
+
+// ---------------------------------------------------------------------------
+// Flow filter: roller-pass notch bank, then a 4th-order Butterworth LPF
+// The notches sit on k·f_roll, f_roll = step rate · ROLLERS / steps-per-rev,
+// retuned every tick; each is NOTCH_Q wide.  With the ripple notched out the
+// low-pass corner no longer has to sit below the slowest roller pass.
+// ---------------------------------------------------------------------------
+constexpr float    FLOW_LPF_HZ          = 2.0f;   // was 0.25 Hz
+constexpr uint8_t  NOTCH_HARMONICS      = 4;      // f_roll … 4·f_roll
+constexpr float    NOTCH_Q              = 2.0f;   // centre / −3 dB width
+constexpr float    NOTCH_MIN_HZ         = 0.1f;   // below: bypassed (pump ~stopped)
+constexpr float    NOTCH_MAX_HZ         = 40.0f;  // keep clear of Nyquist
+
+// ---------------------------------------------------------------------------
+// Step-rate / sensor fusion (FlowKalman)
+// Noise terms are standard deviations; the filter squares them.
+// ---------------------------------------------------------------------------
+constexpr bool     KF_FEEDBACK          = true;   // PID runs on the estimate
+constexpr float    KF_TAU_S             = 0.25f;  // tube compliance, rollers → sensor
+static_assert(KF_TAU_S == RIPPLE_TUBE_TAU_S, "one tube, one time constant");
+constexpr float    KF_R_FLOW_SD         = 8.0f;   // sensor noise, µL/min per sample
+constexpr float    KF_Q_FLOW_SD         = 3.0f;   // model error, µL/min / √s
+constexpr float    KF_Q_GAIN_SD         = 0.007f; // µL/step drift, 1 / √s
+constexpr float    KF_P0_FLOW           = 100.0f; // initial uncertainty, µL/min
+constexpr float    KF_P0_GAIN           = 0.10f;  // … of delivered / nominal
+constexpr float    KF_GAIN_MIN          = 0.5f;
+constexpr float    KF_GAIN_MAX          = 1.5f;
+constexpr float    KF_R_FLOW            = KF_R_FLOW_SD * KF_R_FLOW_SD;
+constexpr float    KF_Q_FLOW            = KF_Q_FLOW_SD * KF_Q_FLOW_SD;
+constexpr float    KF_Q_GAIN            = KF_Q_GAIN_SD * KF_Q_GAIN_SD;
+
 // ---------------------------------------------------------------------------
 // PID default gains (scalar mode) – match min_ctrl.cpp
 // ---------------------------------------------------------------------------
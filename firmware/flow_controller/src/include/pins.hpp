@@ -23,6 +23,17 @@ constexpr uint8_t OLED_ROTATION = 1;     // 0 = portrait, 1 = landscape-USB-down
 constexpr uint8_t PIN_BTN_UP = D8;   // pad-9  GP2
 constexpr uint8_t PIN_BTN_DN = D9;   // pad-10 GP4
 
+/* ── Lab balance (gravimetric calibration only) ────────────── */
+/* No XIAO pad reaches a UART1 pin and the UART0 pads (GP0/1,
+   GP28/29) drive the DRV8825, so on this board the host relays the
+   balance over USB ("G W <g>").  A board that breaks out GP8/GP9
+   defines BAL_UART_PINS and polls the balance directly; the port is
+   opened only while a "G RUN" is in progress.                    */
+#if defined(BAL_UART_PINS)
+constexpr uint8_t PIN_BAL_TX = 8;    // GP8  UART1 TX → balance RxD
+constexpr uint8_t PIN_BAL_RX = 9;    // GP9  UART1 RX ← balance TxD
+#endif
+
 /* ── ON-BOARD WS2812 RGB LED ─────────────────────────────── */
 constexpr uint8_t PIN_RGB_ENABLE = 11;  // GP11 – powers the NeoPixel FET
 constexpr uint8_t PIN_RGB_DATA   = 12;  // GP12 – WS2812 DIN
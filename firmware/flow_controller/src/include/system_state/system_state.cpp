@@ -7,16 +7,18 @@
  */
 
 #include "system_state.hpp"
+#include "../config.hpp"                   // EE_ADDR_STATE, EE_SIZE
 #include <EEPROM.h>
 
 /* ───────── global snapshot & dirty flag ───────── */
 volatile SystemState g_state;
 bool                 State::g_dirty = false;
+static bool          gCommitReq     = false;
 
 /* ───────── EEPROM layout ───────── */
 static constexpr uint32_t MAGIC   = 0x534D3153;   // "SM1S"
 static constexpr uint8_t  VERSION = 1;
-static constexpr int      EE_ADDR = 0;
+static constexpr int      EE_ADDR = EE_ADDR_STATE;
 
 struct PersistBlob {
     uint32_t magic;
@@ -24,15 +26,33 @@ struct PersistBlob {
     float    setpoint_uL;
     uint8_t  pumpEnabled;
 };
+static_assert(EE_ADDR_STATE + sizeof(PersistBlob) <= EE_ADDR_PROGRAM,
+              "PersistBlob overlaps program table");
 
 /* ───────── public helpers ───────── */
 const volatile SystemState& State::read() { return g_state; }
 
+#if defined(ARDUINO_ARCH_RP2040)
+#include "pico/time.h"
+uint64_t State::nowUs() { return time_us_64(); }
+#else
+/* extend micros() by counting wraps; needs a call at least every 71 min */
+uint64_t State::nowUs()
+{
+    static uint32_t last = 0;
+    static uint64_t high = 0;
+    uint32_t now = micros();
+    if (now < last) high += (1ULL << 32);
+    last = now;
+    return high | now;
+}
+#endif
+
 /* Load set-point & pump flag from flash-backed EEPROM */
 void State::loadPersistent()
 {
 #if defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
-    EEPROM.begin(sizeof(PersistBlob));
+    EEPROM.begin(EE_SIZE);                        // whole map, not just this blob
 #endif
     PersistBlob blob{}; EEPROM.get(EE_ADDR, blob);
 
@@ -42,8 +62,8 @@ void State::loadPersistent()
     }
 }
 
-/* Flush when dirty (only set-point & pump flag) */
-void State::commitPersistent()
+/* Stage when dirty (only set-point & pump flag) */
+void State::stagePersistent()
 {
     if (!g_dirty) return;
 
@@ -53,11 +73,21 @@ void State::commitPersistent()
         static_cast<uint8_t>(g_state.pumpEnabled)
     };
     EEPROM.put(EE_ADDR, blob);
+    g_dirty = false;
+    requestCommit();
+}
+
+/* One commit covers every blob put() since the last one */
+void State::requestCommit() { gCommitReq = true; }
 
+bool State::commitStaged()
+{
+    if (!gCommitReq) return false;
+    gCommitReq = false;
 #if defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
     EEPROM.commit();
 #endif
-    g_dirty = false;
+    return true;
 }
 
 /* ───────── setters ───────── */
@@ -5,11 +5,14 @@
 enum LEDColour : uint8_t { LED_OFF, LED_RED, LED_GREEN, LED_BLUE, LED_AMBER };
 
 /* ─── Runtime snapshot ───
- * NB: Only setpoint & pumpEnabled persist to EEPROM; all other
- *     members are live-telemetry only.
+ * NB: Only setpoint & pumpEnabled persist to EEPROM; total_uL and
+ *     runTime_s mirror the Totalizer journal; all other members are
+ *     live-telemetry only.
  */
 struct SystemState {
-    unsigned long currentTimeMs{0};
+    uint64_t currentTimeUs{0};    // 64-bit µs timebase (never wraps)
+    uint32_t currentTimeMs{0};    // currentTimeUs / 1000, for telemetry "t"
+    uint32_t tickDtUs{0};         // measured interval of the last tick
 
     /* user parameters & control */
     float setpoint{0};        // µL / min target
@@ -21,12 +24,63 @@ struct SystemState {
 
     /* controller commands (live) */
     float rpmCmd{0};
-    float spsCmd{0};
-    uint16_t topCmd{0};       // ★ NEW: PWM wrap value actually applied
+    float spsCmd{0};          // rate the pump actually synthesised
+    float spsErrPpm{0};       // … relative to the rate asked for
+    uint16_t topCmd{0};       // ★ NEW: PWM wrap for the rate at 1/32 µ-step
+    uint8_t  ustep{0};        // µ-step divisor in force (0 = fixed)
+    bool     ripple{false};   // roller-ripple modulation applied
+    float    ripplePP{0};     // learned delivery ripple, % peak-to-peak
+
+    /* step / sensor fusion */
+    float    kfFlow{0};       // estimated flow at the sensor, µL / min
+    float    kfVpr{0};        // online µL per revolution
+    uint32_t kfUs{0};         // filter section cost, last tick
+    uint32_t kfUsMax{0};      // … worst since "F CLR"
+    float pidOut{0};          // PID output before TOP conversion (µL / min)
+    float pidP{0};            // its proportional term
+    float pidI{0};            // its integral term (residual after feed-forward)
 
     /* totals */
     float volume_uL{0};
     float mass_g{0};
+    double   total_uL{0};         // lifetime, journaled across resets
+    uint32_t runTime_s{0};        // lifetime pump-on time
+
+    /* air-in-line (SLF3S flag bit 0) */
+    bool     bubble{false};       // guard latched this tick
+    uint32_t bubbleCount{0};      // events since boot
+    uint32_t bubbleLastMs{0};     // start of most recent event
+    uint32_t bubbleTotalMs{0};    // cumulative time latched
+
+    /* flow-sensor link */
+    uint8_t  sensState{0};        // Hal::SensorState
+    bool     sensOk{false};       // this tick's sample was good
+    float    sensGoodPct{0};      // good samples in the last window (%)
+    uint32_t sensErrs{0};         // read errors since boot
+    uint32_t sensStale{0};        // stale-timeout events
+    uint32_t sensClears{0};       // bus-clear / re-init attempts
+    uint32_t sensRestarts{0};     // successful re-starts
+
+    /* temperature compensation */
+    float   tempC{NAN};           // sensor temperature (°C)
+    float   tcSens{1};            // applied sensor gain
+    float   tcRate{1};            // applied delivery gain
+
+    /* delivery monitor */
+    uint8_t occlState{0};         // OcclusionDetector::State
+    float   occlRatio{1};         // measured / expected volume, 2 s window
+
+    /* set-point program */
+    uint8_t progState{0};         // Program::Run
+    uint8_t progStep{0};          // active step index
+    float   progSp{0};            // set-point actually tracked (µL / min)
+
+    /* exact-volume dose */
+    uint8_t dosePhase{0};         // Dose::Phase
+    float   doseRem_uL{0};        // odometer volume still to go
+
+    /* gravimetric calibration */
+    uint8_t gcalPhase{0};         // GravCal::Phase
 
     /* state flags */
     bool  pumpEnabled{false};
@@ -46,9 +100,18 @@ namespace State {
     /* snapshot read-only accessor */
     const volatile SystemState& read();
 
+    /* 64-bit µs clock (time_us_64 on RP2040, extended micros() elsewhere) */
+    uint64_t nowUs();
+
     /* EEPROM helpers (store set-point & pump flag only) */
     void loadPersistent();
-    void commitPersistent();
+    void stagePersistent();             // put() if dirty, request a commit
+
+    /* EEPROM.put() only writes the RAM image; the commit rewrites the
+       whole sector with interrupts masked, so it is requested here and
+       run by ctrlLoop between ticks, never inside one.               */
+    void requestCommit();
+    bool commitStaged();                // true if it wrote
 
     /* setters (some mark EEPROM dirty) */
     void setSetpoint(float v);          // µL/min
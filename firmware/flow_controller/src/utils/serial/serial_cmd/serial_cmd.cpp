@@ -0,0 +1,263 @@
+/*  serial_cmd.cpp – ASCII command parser
+ *  -------------------------------------
+ *  | Command              | Meaning                                   |
+ *  |----------------------|-------------------------------------------|
+ *  | P CLR                | clear program table                       |
+ *  | P ADD R <sp> <ms>    | ramp to <sp> µL/min over <ms>             |
+ *  | P ADD H <ms>         | hold current set-point for <ms>           |
+ *  | P ADD D <uL>         | hold until <uL> more volume is dispensed  |
+ *  | P ADD W              | hold until "P GO" or a button press       |
+ *  | P RUN / P STOP       | start / abort; the last SP is kept at END |
+ *  | P GO                 | release a WAIT step                       |
+ *  | P SAVE               | persist table to EEPROM                   |
+ *  | P LIST               | print table                               |
+ *  | D <uL>               | dispense exactly <uL> at SP, not during G |
+ *  | D STOP               | abort the running dose                    |
+ *  | D STAT               | print dose-accuracy statistics            |
+ *  | S <field> <n>        | stream <field> every <n> ticks (0 = off)  |
+ *  | S ALL <n> / S NONE   | subscribe every field / clear all         |
+ *  | S LIST               | print fields and their decimation         |
+ *  | J / J CLR            | print / clear tick-jitter histogram       |
+ *  | F / F CLR            | print / restart the step-sensor fusion    |
+ *  | B                    | live step() time since last B, and RAM    |
+ *  | T / T CLR            | print / zero the lifetime totalizer       |
+ *  | K                    | print the temperature-correction table    |
+ *  | K REF <uL>           | weighed volume of the last dose → sensor  |
+ *  | K CLR / K SAVE       | reset table to 1 / persist to EEPROM      |
+ *  | C                    | print calibration pairs and gain grid     |
+ *  | C ADD <ind> <true>   | add / replace a pair (raw µL/min) + refit |
+ *  | C DEL <i>            | drop pair <i> and refit                   |
+ *  | C CLR / C SAVE       | no pairs (gain 1) / persist to EEPROM     |
+ *  | G RUN [n]            | gravimetric cal over n points (balance)   |
+ *  | G STOP               | abort it, keep the stored curve           |
+ *  | G                    | print run status and weighed points       |
+ *  | G W <g> [D]          | balance weight relayed by the host (USB)  |
+ *  | R                    | print the roller-ripple gain table        |
+ *  | R ON / R OFF         | modulate the step rate by it / don't      |
+ *  | R CLR                | flat table, relearn                       |
+ */
+
+#include "serial_cmd.hpp"
+#include "../../../include/_include.hpp"
+#include "../../../core/_core.hpp"
+#include "../../../ctrl/min_ctrl/min_ctrl.hpp"        // tick stats, bench
+#include "../../../devices/balance/balance.hpp"       // G W relay
+#include "../serial_rpt/serial_rpt.hpp"
+#include <strings.h>                                 // strcasecmp
+
+
+namespace {
+
+char    buf[64];
+uint8_t len = 0;
+
+/* next whitespace-separated token (uppercased unless raw), or nullptr */
+char* nextTok(char*& p, bool raw = false)
+{
+    while (*p == ' ') ++p;
+    if (!*p) return nullptr;
+    char* t = p;
+    while (*p && *p != ' ') { if (!raw) *p = toupper(*p); ++p; }
+    if (*p) *p++ = '\0';
+    return t;
+}
+
+bool eq(const char* a, const char* b) { return a && strcmp(a, b) == 0; }
+
+/* ───── P … : set-point program ───── */
+bool handleProgram(char* p, Stream& s)
+{
+    using namespace Program;
+    char* sub = nextTok(p);
+
+    if (eq(sub, "CLR"))  return clear();
+    if (eq(sub, "RUN"))  return start(g_state.setpoint);
+    if (eq(sub, "STOP")) { stop();   return true; }
+    if (eq(sub, "GO"))   { signal(); return true; }
+    if (eq(sub, "SAVE")) { save();   return true; }
+
+    if (eq(sub, "LIST")) {
+        for (uint8_t i = 0; i < count(); ++i) {
+            const Step& st = step(i);
+            s.print(F("P ")); s.print(i);
+            s.print(' ');     s.print(static_cast<uint8_t>(st.op));
+            s.print(' ');     s.print(st.value, 1);
+            s.print(' ');     s.println(st.ms);
+        }
+        return true;
+    }
+
+    if (eq(sub, "ADD")) {
+        char* kind = nextTok(p);
+        char* a1   = nextTok(p);
+        char* a2   = nextTok(p);
+        Step st;
+        if      (eq(kind, "R") && a1 && a2) st = {Op::RAMP, (float)atof(a1), (uint32_t)atol(a2)};
+        else if (eq(kind, "H") && a1)       st = {Op::HOLD, 0.0f,            (uint32_t)atol(a1)};
+        else if (eq(kind, "D") && a1)       st = {Op::DOSE, (float)atof(a1), 0};
+        else if (eq(kind, "W"))             st = {Op::WAIT, 0.0f,            0};
+        else return false;
+        return add(st);
+    }
+    return false;
+}
+
+/* ───── D … : exact-volume dose ───── */
+bool handleDose(char* p, Stream&)
+{
+    char* arg = nextTok(p);
+    if (eq(arg, "STOP")) { Dose::abort(); return true; }
+    if (eq(arg, "STAT")) { SerialRpt::emitDoseJSON(Dose::stats()); return true; }
+    if (GravCal::active()) return false;             // it owns SP and enable
+    return arg && Dose::request(static_cast<float>(atof(arg)));
+}
+
+/* ───── S … : telemetry subscriptions ───── */
+bool handleSubscribe(char* p, Stream& s)
+{
+    char*    field = nextTok(p, true);               // field names are lower-case
+    char*    arg   = nextTok(p);
+    uint16_t every = arg ? static_cast<uint16_t>(atol(arg)) : 0;
+    if (!field) return false;
+
+    if (!strcasecmp(field, "LIST")) { SerialRpt::listFields(s);    return true; }
+    if (!strcasecmp(field, "NONE")) { SerialRpt::subscribeAll(0);  return true; }
+    if (!strcasecmp(field, "ALL"))  { SerialRpt::subscribeAll(every); return true; }
+    return SerialRpt::subscribe(field, every);
+}
+
+/* ───── J : tick-interval histogram ───── */
+bool handleJitter(char* p, Stream&)
+{
+    char* arg = nextTok(p);
+    if (eq(arg, "CLR")) { ctrlTickStats().reset(); return true; }
+    SerialRpt::emitTickJSON(ctrlTickStats());
+    return !arg;
+}
+
+/* ───── F … : step / sensor fusion ───── */
+bool handleKalman(char* p, Stream&)
+{
+    char* arg = nextTok(p);
+    if (eq(arg, "CLR")) { ctrlKalman().reset(); g_state.kfUsMax = 0; return true; }
+    SerialRpt::emitKalmanJSON(ctrlKalman());
+    return !arg;
+}
+
+/* ───── B : cost of the running loop ───── */
+bool handleBench(char*, Stream&)
+{
+    return ctrlRequestBench();          // report follows between ticks
+}
+
+/* ───── T : lifetime totalizer ───── */
+bool handleTotal(char* p, Stream&)
+{
+    char* arg = nextTok(p);
+    if (eq(arg, "CLR")) { Totalizer::clear(); return true; }
+    SerialRpt::emitTotalJSON();
+    return !arg;
+}
+
+/* ───── K … : temperature compensation ───── */
+bool handleTempComp(char* p, Stream&)
+{
+    char* arg = nextTok(p);
+    if (eq(arg, "CLR"))  { TempComp::reset(); TempComp::save(); return true; }
+    if (eq(arg, "SAVE")) { TempComp::save(); return true; }
+    if (eq(arg, "REF")) {
+        char* v = nextTok(p);
+        const Dose::Stats& ds = Dose::stats();
+        if (!v || !ds.runs || Dose::active()) return false;
+        if (!TempComp::learnSensor(g_state.tempC, atof(v), ds.meas_uL)) return false;
+        TempComp::save();
+        return true;
+    }
+    SerialRpt::emitTempCompJSON();
+    return !arg;
+}
+
+/* ───── C … : multi-point sensor calibration ───── */
+bool handleCalCurve(char* p, Stream&)
+{
+    char* arg = nextTok(p);
+    if (eq(arg, "CLR"))  { CalCurve::clear(); return true; }
+    if (eq(arg, "SAVE")) { CalCurve::save();  return true; }
+    if (eq(arg, "DEL")) {
+        char* i = nextTok(p);
+        return i && CalCurve::remove(atoi(i));
+    }
+    if (eq(arg, "ADD")) {
+        char* ind = nextTok(p);
+        char* ref = nextTok(p);
+        return ind && ref && CalCurve::add(atof(ind), atof(ref));
+    }
+    SerialRpt::emitCalCurveJSON();
+    return !arg;
+}
+
+/* ───── G … : gravimetric calibration ───── */
+bool handleGravCal(char* p, Stream&)
+{
+    char* arg = nextTok(p);
+    if (eq(arg, "STOP")) { GravCal::abort(); return true; }
+    if (eq(arg, "W")) {                              // USB balance relay
+        char* g = nextTok(p);
+        char* d = nextTok(p);
+        return g && Balance::push(atof(g), !eq(d, "D"), millis());
+    }
+    if (eq(arg, "RUN")) {
+        if (Dose::active() || Program::active()) return false;
+        char* n = nextTok(p);
+        return GravCal::request(n ? atoi(n) : GCAL_DEFAULT_POINTS);
+    }
+    SerialRpt::emitGravJSON();
+    return !arg;
+}
+
+/* ───── R … : roller-ripple compensation ───── */
+bool handleRipple(char* p, Stream&)
+{
+    char* arg = nextTok(p);
+    if (eq(arg, "ON"))  { Ripple::enable(true);  return true; }
+    if (eq(arg, "OFF")) { Ripple::enable(false); return true; }
+    if (eq(arg, "CLR")) { Ripple::clear();       return true; }
+    SerialRpt::emitRippleJSON();
+    return !arg;
+}
+
+void handleLine(char* line, Stream& s)
+{
+    char* p   = line;
+    char* cmd = nextTok(p);
+    bool  ok  = false;
+
+    if      (eq(cmd, "P")) ok = handleProgram(p, s);
+    else if (eq(cmd, "D")) ok = handleDose(p, s);
+    else if (eq(cmd, "S")) ok = handleSubscribe(p, s);
+    else if (eq(cmd, "J")) ok = handleJitter(p, s);
+    else if (eq(cmd, "F")) ok = handleKalman(p, s);
+    else if (eq(cmd, "B")) ok = handleBench(p, s);
+    else if (eq(cmd, "T")) ok = handleTotal(p, s);
+    else if (eq(cmd, "K")) ok = handleTempComp(p, s);
+    else if (eq(cmd, "C")) ok = handleCalCurve(p, s);
+    else if (eq(cmd, "G")) ok = handleGravCal(p, s);
+    else if (eq(cmd, "R")) ok = handleRipple(p, s);
+
+    s.println(ok ? F("OK") : F("ERR"));
+}
+
+}   // namespace
+
+void SerialCmd::poll(Stream& s)
+{
+    while (s.available()) {
+        char c = s.read();
+        if (c == '\n' || c == '\r') {
+            if (len) { buf[len] = '\0'; handleLine(buf, s); len = 0; }
+        } else if (len < sizeof(buf) - 1) {
+            buf[len++] = c;
+        }
+    }
+}
+
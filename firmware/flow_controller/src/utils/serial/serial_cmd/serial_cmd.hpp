@@ -0,0 +1,16 @@
+#ifndef SERIAL_CMD_HPP
+#define SERIAL_CMD_HPP
+
+/*  serial_cmd.hpp – line-oriented ASCII command parser
+ *  ---------------------------------------------------
+ *  One command per line, terminated by '\n' (or '\r').
+ *  Replies "OK …" or "ERR …".  See serial_cmd.cpp for the table.
+ */
+
+#include <Arduino.h>
+
+namespace SerialCmd {
+void poll(Stream& s);           // non-blocking; call every tick
+} // namespace SerialCmd
+
+#endif /* SERIAL_CMD_HPP */
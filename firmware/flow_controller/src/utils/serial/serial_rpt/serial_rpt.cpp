@@ -1,35 +1,323 @@
 #include <Arduino.h>
 #include "serial_rpt.hpp"
+#include "../../../devices/balance/balance.hpp"   // error count
 
 namespace SerialRpt
 {
-    void emitJSON(const volatile SystemState& st)
-    {
-        Serial.print('{');
-
-        /* core timing */
-        Serial.print(F("\"t\":"));      Serial.print(st.currentTimeMs);
+    /* ───── field registry ─────
+     * Every telemetry field is listed exactly once here.  A field is
+     * only read and printed when it sits in the active list below, so
+     * an unsubscribed field costs nothing per tick.                   */
+    using Getter = double (*)(const volatile SystemState&);
+    struct FieldDef { const char* name; Getter get; uint8_t dec; };
 
+    static const FieldDef FIELDS[] = {
         /* set-point & flows */
-        Serial.print(F(",\"sp\":"));    Serial.print(st.setpoint, 0);
-        Serial.print(F(",\"r_flw\":")); Serial.print(st.r_flow,   0);   // raw
-        Serial.print(F(",\"f_flw\":")); Serial.print(st.f_flow,   0);   // filtered
+        {"sp",     [](const volatile SystemState& s) -> double { return s.setpoint;      }, 0},
+        {"r_flw",  [](const volatile SystemState& s) -> double { return s.r_flow;        }, 0},
+        {"f_flw",  [](const volatile SystemState& s) -> double { return s.f_flow;        }, 0},
+        {"kf",     [](const volatile SystemState& s) -> double { return s.kfFlow;        }, 1},
+        {"vpr",    [](const volatile SystemState& s) -> double { return s.kfVpr;         }, 2},
+        {"kf_us",  [](const volatile SystemState& s) -> double { return s.kfUs;          }, 0},
 
         /* drive commands */
-        Serial.print(F(",\"rpm\":"));   Serial.print(st.rpmCmd, 1);
-        Serial.print(F(",\"sps\":"));   Serial.print(st.spsCmd, 0);
-        Serial.print(F(",\"top\":"));   Serial.print(st.topCmd);        // ★ NEW
+        {"rpm",    [](const volatile SystemState& s) -> double { return s.rpmCmd;        }, 1},
+        {"sps",    [](const volatile SystemState& s) -> double { return s.spsCmd;        }, 2},
+        {"sps_ppm",[](const volatile SystemState& s) -> double { return s.spsErrPpm;     }, 1},
+        {"top",    [](const volatile SystemState& s) -> double { return s.topCmd;        }, 0},
+        {"ustep",  [](const volatile SystemState& s) -> double { return s.ustep;         }, 0},
+        {"rip",    [](const volatile SystemState& s) -> double { return s.ripple;        }, 0},
+        {"rip_pp", [](const volatile SystemState& s) -> double { return s.ripplePP;      }, 1},
+        {"pid",    [](const volatile SystemState& s) -> double { return s.pidOut;        }, 0},
+        {"pid_p",  [](const volatile SystemState& s) -> double { return s.pidP;          }, 1},
+        {"pid_i",  [](const volatile SystemState& s) -> double { return s.pidI;          }, 1},
 
         /* calibration scalar */
-        Serial.print(F(",\"cal%\":"));  Serial.print(st.calScalar, 0);
+        {"cal%",   [](const volatile SystemState& s) -> double { return s.calScalar;     }, 0},
 
         /* totals */
-        Serial.print(F(",\"vol_uL\":"));Serial.print(st.volume_uL, 0);
-        Serial.print(F(",\"mass_g\":"));Serial.print(st.mass_g, 3);
+        {"vol_uL", [](const volatile SystemState& s) -> double { return s.volume_uL;     }, 0},
+        {"mass_g", [](const volatile SystemState& s) -> double { return s.mass_g;        }, 3},
 
         /* flags */
-        Serial.print(F(",\"on\":"));    Serial.print(State::isPumpEnabled() ? 1 : 0);
+        {"on",     [](const volatile SystemState& s) -> double { return s.pumpEnabled;   }, 0},
+
+        /* set-point program */
+        {"p_st",   [](const volatile SystemState& s) -> double { return s.progState;     }, 0},
+        {"p_idx",  [](const volatile SystemState& s) -> double { return s.progStep;      }, 0},
+        {"p_sp",   [](const volatile SystemState& s) -> double { return s.progSp;        }, 0},
+
+        /* exact-volume dose */
+        {"dose",   [](const volatile SystemState& s) -> double { return s.dosePhase;     }, 0},
+        {"d_rem",  [](const volatile SystemState& s) -> double { return s.doseRem_uL;    }, 1},
+
+        /* gravimetric calibration */
+        {"gcal",   [](const volatile SystemState& s) -> double { return s.gcalPhase;     }, 0},
+
+        /* air-in-line events */
+        {"bub",    [](const volatile SystemState& s) -> double { return s.bubble;        }, 0},
+        {"bub_n",  [](const volatile SystemState& s) -> double { return s.bubbleCount;   }, 0},
+        {"bub_t",  [](const volatile SystemState& s) -> double { return s.bubbleLastMs;  }, 0},
+        {"bub_ms", [](const volatile SystemState& s) -> double { return s.bubbleTotalMs; }, 0},
+
+        /* flow-sensor link */
+        {"s_st",   [](const volatile SystemState& s) -> double { return s.sensState;     }, 0},
+        {"s_ok",   [](const volatile SystemState& s) -> double { return s.sensOk;        }, 0},
+        {"s_good", [](const volatile SystemState& s) -> double { return s.sensGoodPct;   }, 1},
+        {"s_err",  [](const volatile SystemState& s) -> double { return s.sensErrs;      }, 0},
+        {"s_stl",  [](const volatile SystemState& s) -> double { return s.sensStale;     }, 0},
+        {"s_clr",  [](const volatile SystemState& s) -> double { return s.sensClears;    }, 0},
+        {"s_rst",  [](const volatile SystemState& s) -> double { return s.sensRestarts;  }, 0},
+
+        /* lifetime totals */
+        {"tot",    [](const volatile SystemState& s) -> double { return s.total_uL;      }, 1},
+        {"run_s",  [](const volatile SystemState& s) -> double { return s.runTime_s;     }, 0},
+
+        /* temperature compensation */
+        {"temp",   [](const volatile SystemState& s) -> double { return s.tempC;         }, 2},
+        {"k_sen",  [](const volatile SystemState& s) -> double { return s.tcSens;        }, 4},
+        {"k_rate", [](const volatile SystemState& s) -> double { return s.tcRate;        }, 4},
+
+        /* delivery monitor */
+        {"occl",   [](const volatile SystemState& s) -> double { return s.occlState;     }, 0},
+        {"occ_r",  [](const volatile SystemState& s) -> double { return s.occlRatio;     }, 3},
+
+        /* profiler */
+        {"dt_us",  [](const volatile SystemState& s) -> double { return s.tickDtUs;      }, 0},
+    };
+    static constexpr uint8_t N_FIELDS = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+    /* ───── active subscriptions (compact, registry order) ───── */
+    struct Sub { uint8_t idx; uint16_t every; uint16_t left; };
+    static Sub     subs[N_FIELDS];
+    static uint8_t nSubs = 0;
+
+    static int8_t lookup(const char* name)
+    {
+        for (uint8_t i = 0; i < N_FIELDS; ++i)
+            if (!strcmp(FIELDS[i].name, name)) return i;
+        return -1;
+    }
+
+    bool subscribe(const char* name, uint16_t every)
+    {
+        int8_t idx = lookup(name);
+        if (idx < 0) return false;
+
+        uint8_t pos = 0;                                 // keep registry order
+        while (pos < nSubs && subs[pos].idx < idx) ++pos;
+        bool present = (pos < nSubs && subs[pos].idx == idx);
+
+        if (!every) {                                    // unsubscribe
+            if (!present) return true;
+            memmove(&subs[pos], &subs[pos + 1], (nSubs - pos - 1) * sizeof(Sub));
+            --nSubs;
+            return true;
+        }
+        if (!present) {
+            memmove(&subs[pos + 1], &subs[pos], (nSubs - pos) * sizeof(Sub));
+            ++nSubs;
+        }
+        subs[pos] = {static_cast<uint8_t>(idx), every, 1};
+        return true;
+    }
+
+    void subscribeAll(uint16_t every)
+    {
+        nSubs = 0;
+        if (!every) return;
+        for (uint8_t i = 0; i < N_FIELDS; ++i) subs[nSubs++] = {i, every, 1};
+    }
+
+    void listFields(Print& out)
+    {
+        for (uint8_t i = 0; i < N_FIELDS; ++i) {
+            uint16_t every = 0;
+            for (uint8_t k = 0; k < nSubs; ++k)
+                if (subs[k].idx == i) every = subs[k].every;
+            out.print(FIELDS[i].name); out.print(' '); out.println(every);
+        }
+    }
+
+    /* one line per tick holding every field that is due */
+    void tick(const volatile SystemState& st)
+    {
+        bool open = false;
+        for (uint8_t k = 0; k < nSubs; ++k) {
+            Sub& sb = subs[k];
+            if (--sb.left) continue;
+            sb.left = sb.every;
+
+            if (!open) {
+                Serial.print(F("{\"t\":")); Serial.print(st.currentTimeMs);
+                open = true;
+            }
+            const FieldDef& f = FIELDS[sb.idx];
+            Serial.print(F(",\""));  Serial.print(f.name);
+            Serial.print(F("\":"));  Serial.print(f.get(st), f.dec);
+        }
+        if (open) Serial.println('}');
+    }
+
+    void emitDoseJSON(const Dose::Stats& ds)
+    {
+        Serial.print(F("{\"dose_run\":"));Serial.print(ds.runs);
+
+        /* this run */
+        Serial.print(F(",\"tgt_uL\":"));  Serial.print(ds.target_uL, 1);
+        Serial.print(F(",\"stp_uL\":"));  Serial.print(ds.step_uL,   2);
+        Serial.print(F(",\"meas_uL\":")); Serial.print(ds.meas_uL,   1);
+        Serial.print(F(",\"err%\":"));    Serial.print(ds.err_pct,   2);
+        Serial.print(F(",\"ms\":"));      Serial.print(ds.run_ms);
+
+        /* all runs */
+        Serial.print(F(",\"mean%\":"));   Serial.print(ds.meanErr_pct,    2);
+        Serial.print(F(",\"mabs%\":"));   Serial.print(ds.meanAbsErr_pct, 2);
+        Serial.print(F(",\"worst%\":"));  Serial.print(ds.worstErr_pct,   2);
+
+        Serial.println('}');
+    }
 
+    void emitTickJSON(const TickStats& ts)
+    {
+        Serial.print(F("{\"jit_n\":"));   Serial.print(ts.count());
+        Serial.print(F(",\"min_us\":"));  Serial.print(ts.min_us());
+        Serial.print(F(",\"mean_us\":")); Serial.print(ts.mean_us(), 1);
+        Serial.print(F(",\"max_us\":"));  Serial.print(ts.max_us());
+        Serial.print(F(",\"dv_uL\":"));   Serial.print(ts.dvErr_uL(), 3);
+
+        /* log2 bins: h[k] counts dt in [2^(k-1), 2^k) µs */
+        Serial.print(F(",\"h\":["));
+        for (uint8_t k = 0; k < TickStats::BINS; ++k) {
+            if (k) Serial.print(',');
+            Serial.print(ts.bin(k));
+        }
+        Serial.println(F("]}"));
+    }
+
+    void emitOcclJSON(const OcclusionDetector& od)
+    {
+        static const char* const NAME[] = {"ok", "occluded", "stalled", "free_flow"};
+        Serial.print(F("{\"occl\":\""));  Serial.print(NAME[static_cast<uint8_t>(od.state())]);
+        Serial.print(F("\",\"ratio\":"));Serial.print(od.ratio(),    3);
+        Serial.print(F(",\"exp\":"));     Serial.print(od.expRate(),  1);
+        Serial.print(F(",\"meas\":"));    Serial.print(od.measRate(), 1);
+        Serial.print(F(",\"n\":"));       Serial.print(od.events());
+        Serial.println('}');
+    }
+
+    void emitKalmanJSON(const FlowKalman& kf)
+    {
+        Serial.print(F("{\"kf\":"));    Serial.print(kf.flow(), 1);
+        Serial.print(F(",\"q_sd\":"));  Serial.print(sqrtf(kf.flowVar()), 2);
+        Serial.print(F(",\"k\":"));     Serial.print(kf.gain(), 4);
+        Serial.print(F(",\"k_sd\":"));  Serial.print(sqrtf(kf.gainVar()), 4);
+        Serial.print(F(",\"vpr\":"));   Serial.print(g_state.kfVpr, 2);
+        Serial.print(F(",\"innov\":")); Serial.print(kf.innov(), 1);
+        Serial.print(F(",\"us\":"));    Serial.print(g_state.kfUs);
+        Serial.print(F(",\"us_max\":"));Serial.print(g_state.kfUsMax);
+        Serial.println('}');
+    }
+
+    void emitTotalJSON()
+    {
+        Serial.print(F("{\"tot_uL\":"));  Serial.print(Totalizer::total_uL(), 1);
+        Serial.print(F(",\"run_s\":"));   Serial.print(Totalizer::runTime_s());
+        Serial.print(F(",\"seq\":"));     Serial.print(Totalizer::sequence());
+        Serial.print(F(",\"ckpt\":"));    Serial.print(Totalizer::checkpoints());
+        Serial.print(F(",\"rail\":"));    Serial.print(Totalizer::railDown() ? 0 : 1);
+        Serial.println('}');
+    }
+
+    void emitTempCompJSON()
+    {
+        /* one row per grid point: [°C, sensor gain, delivery gain, runs] */
+        Serial.print(F("{\"tc\":["));
+        for (uint8_t i = 0; i < TC_POINTS; ++i) {
+            if (i) Serial.print(',');
+            Serial.print('[');  Serial.print(TempComp::pointC(i),   1);
+            Serial.print(',');  Serial.print(TempComp::sensorAt(i), 4);
+            Serial.print(',');  Serial.print(TempComp::rateAt(i),   4);
+            Serial.print(',');  Serial.print(TempComp::runsAt(i));
+            Serial.print(']');
+        }
+        Serial.println(F("]}"));
+    }
+
+    void emitCalCurveJSON()
+    {
+        /* pairs: [indicated, true] µL/min;  grid: gain per CAL_GRID_STEP_UL */
+        Serial.print(F("{\"cal\":["));
+        for (uint8_t i = 0; i < CalCurve::count(); ++i) {
+            const CalCurve::Pair& p = CalCurve::pair(i);
+            if (i) Serial.print(',');
+            Serial.print('[');  Serial.print(p.ind, 1);
+            Serial.print(',');  Serial.print(p.ref, 1);
+            Serial.print(']');
+        }
+        Serial.print(F("],\"step\":"));  Serial.print(CAL_GRID_STEP_UL, 1);
+        Serial.print(F(",\"k\":["));
+        for (uint8_t i = 0; i < CAL_GRID_POINTS; ++i) {
+            if (i) Serial.print(',');
+            Serial.print(CalCurve::gridGain(i), 4);
+        }
+        Serial.println(F("]}"));
+    }
+
+    void emitRippleJSON()
+    {
+        /* delivery gain per angle bin, bin 0 at odometer 0 mod one rev */
+        Serial.print(F("{\"rip\":"));   Serial.print(Ripple::enabled() ? 1 : 0);
+        Serial.print(F(",\"act\":"));   Serial.print(Ripple::active() ? 1 : 0);
+        Serial.print(F(",\"revs\":"));  Serial.print(Ripple::revs());
+        Serial.print(F(",\"g\":["));
+        for (uint8_t i = 0; i < RIPPLE_BINS; ++i) {
+            if (i) Serial.print(',');
+            Serial.print(Ripple::gainAt(i), 4);
+        }
+        Serial.println(F("]}"));
+    }
+
+    static void printGravPoint(const GravCal::Point& p)
+    {
+        /* [set-point, indicated, balance, readings, accepted] */
+        Serial.print('[');  Serial.print(p.sp,  0);
+        Serial.print(',');  Serial.print(p.ind, 1);
+        Serial.print(',');  Serial.print(p.ref, 1);
+        Serial.print(',');  Serial.print(p.readings);
+        Serial.print(',');  Serial.print(p.ok ? 1 : 0);
+        Serial.print(']');
+    }
+
+    void emitGravPointJSON(const GravCal::Point& p)
+    {
+        Serial.print(F("{\"gcal_pt\":"));
+        printGravPoint(p);
+        Serial.println('}');
+    }
+
+    void emitGravJSON()
+    {
+        Serial.print(F("{\"gcal\":"));    Serial.print(static_cast<uint8_t>(GravCal::phase()));
+        Serial.print(F(",\"fault\":"));   Serial.print(static_cast<uint8_t>(GravCal::fault()));
+        Serial.print(F(",\"cur\":"));     Serial.print(GravCal::current());
+        Serial.print(F(",\"bal_err\":")); Serial.print(Balance::errors());
+        Serial.print(F(",\"pts\":["));
+        for (uint8_t i = 0; i < GravCal::points(); ++i) {
+            if (i) Serial.print(',');
+            printGravPoint(GravCal::point(i));
+        }
+        Serial.println(F("]}"));
+    }
+
+    void emitBenchJSON(const char* cfg, uint32_t ramBytes, uint32_t n,
+                       float mean_us, uint32_t max_us)
+    {
+        Serial.print(F("{\"cfg\":\""));   Serial.print(cfg);
+        Serial.print(F("\",\"ram\":"));   Serial.print(ramBytes);
+        Serial.print(F(",\"n\":"));       Serial.print(n);
+        Serial.print(F(",\"mean_us\":")); Serial.print(mean_us, 1);
+        Serial.print(F(",\"max_us\":"));  Serial.print(max_us);
         Serial.println('}');
     }
 }   // namespace SerialRpt
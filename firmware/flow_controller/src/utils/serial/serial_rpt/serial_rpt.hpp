@@ -2,9 +2,38 @@
 #define SERIAL_RPT_HPP
 
 #include "../../../include/system_state/system_state.hpp"
+#include "../../../core/dose/dose.hpp"
+#include "../../../core/tick_stats/tick_stats.hpp"
+#include "../../../core/occlusion/occlusion.hpp"
+#include "../../../core/totalizer/totalizer.hpp"
+#include "../../../core/temp_comp/temp_comp.hpp"
+#include "../../../core/cal_curve/cal_curve.hpp"
+#include "../../../core/grav_cal/grav_cal.hpp"
+#include "../../../core/ripple/ripple.hpp"
+#include "../../../core/flow_kf/flow_kf.hpp"
 
+/*  Subscribe-style telemetry.  Each field is registered once in
+ *  serial_rpt.cpp; a client picks fields and a decimation ratio
+ *  ("every" control ticks, 1 = full tick rate).  tick() emits one
+ *  {"t":…} line holding whatever is due that tick.               */
 namespace SerialRpt {
-void emitJSON(const volatile SystemState& st);
+bool subscribe(const char* name, uint16_t every);   // every = 0 ⇒ unsubscribe
+void subscribeAll(uint16_t every);
+void listFields(Print& out);                        // "<name> <every>" per line
+void tick(const volatile SystemState& st);          // once per control tick
+
+void emitDoseJSON(const Dose::Stats& ds);           // one line per finished dose
+void emitTickJSON(const TickStats& ts);             // on-demand jitter histogram
+void emitOcclJSON(const OcclusionDetector& od);     // one line per state change
+void emitKalmanJSON(const FlowKalman& kf);          // fusion state + cost ("F")
+void emitTotalJSON();                               // lifetime totalizer ("T")
+void emitTempCompJSON();                            // temperature table ("K")
+void emitCalCurveJSON();                            // calibration curve ("C")
+void emitGravPointJSON(const GravCal::Point& p);    // one line per weighed point
+void emitGravJSON();                                // run status + all points ("G")
+void emitRippleJSON();                              // ripple gain table ("R")
+void emitBenchJSON(const char* cfg, uint32_t ramBytes, uint32_t n,
+                   float mean_us, uint32_t max_us);  // one line per config
 } // namespace SerialRpt
 
 #endif /* SERIAL_RPT_HPP */
@@ -0,0 +1,92 @@
+/*
+  test_balance_stub.ino
+  • Emulates the lab balance for the gravimetric calibration ("G RUN").
+    Answers MT-SICS "SI" on UART1 with "S D <mass> g" (or "S S" when
+    the emulated flow is 0), the only request the controller sends.
+  • Mass integrates a flow set from the USB Serial Monitor:
+        <uL/min>   e.g. "850"  – set the emulated flow
+        z          – tare (mass = 0)
+    delayed by LAG_MS like a dripping outlet, plus ±0.5 mg noise.
+
+  Wiring (any RP2040 board, crossed over to a controller built with
+  BAL_UART_PINS – the XIAO has no free UART pad, see pins.hpp):
+      GP8 (TX) → controller GP9 (RX)
+      GP9 (RX) ← controller GP8 (TX)
+      GND      – GND
+  On the XIAO the host relays instead: poll this stub (or the real
+  balance) and send each weight to the controller as "G W <g>".
+*/
+
+#include <Arduino.h>
+
+/* ── emulation parameters ───────────────────────────────────────────── */
+constexpr uint32_t BAUD       = 9600;
+constexpr uint8_t  PIN_TX     = 8;
+constexpr uint8_t  PIN_RX     = 9;
+constexpr float    DENSITY    = 0.97f;     // g/mL
+constexpr uint32_t LAG_MS     = 5'000;     // outlet / balance delay
+constexpr uint16_t HIST       = 64;        // lag line, 100 ms per slot
+
+float    flow_uLmin = 0.0f;
+double   mass_g     = 0.0;
+float    hist[HIST] = {};                  // flow LAG_MS ago, ring
+uint16_t head       = 0;
+uint32_t lastStep   = 0;
+
+char     line[32];
+uint8_t  len = 0;
+
+/* ── helpers ────────────────────────────────────────────────────────── */
+void integrate()
+{
+    uint32_t now = millis();
+    while (now - lastStep >= 100) {
+        lastStep += 100;
+        hist[head] = flow_uLmin;
+        head = (head + 1) % HIST;
+        float lagged = hist[(head + HIST - LAG_MS / 100) % HIST];
+        mass_g += lagged / 60'000.0 * 100.0 / 1000.0 * DENSITY;   // 100 ms
+    }
+}
+
+void answer()
+{
+    float noise = (random(-50, 51)) * 1e-5f;
+    Serial2.print(flow_uLmin > 0 ? F("S D ") : F("S S "));
+    Serial2.print(mass_g + noise, 4);
+    Serial2.print(F(" g\r\n"));
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    Serial2.setTX(PIN_TX);
+    Serial2.setRX(PIN_RX);
+    Serial2.begin(BAUD);
+    lastStep = millis();
+}
+
+void loop()
+{
+    integrate();
+
+    /* controller side: one "SI" per reading */
+    while (Serial2.available()) {
+        char c = Serial2.read();
+        if (c == '\r') continue;
+        if (c != '\n') { if (len < sizeof(line) - 1) line[len++] = c; continue; }
+        line[len] = '\0'; len = 0;
+        if (strcmp(line, "SI") == 0) answer();
+        else                         Serial2.print(F("ES\r\n"));   // syntax error
+    }
+
+    /* operator side */
+    if (Serial.available()) {
+        String s = Serial.readStringUntil('\n');
+        s.trim();
+        if (s == "z") mass_g = 0.0;
+        else          flow_uLmin = s.toFloat();
+        Serial.print(F("flow ")); Serial.print(flow_uLmin, 0);
+        Serial.print(F(" uL/min  mass ")); Serial.println(mass_g, 4);
+    }
+}
@@ -0,0 +1,76 @@
+/*
+  test_odo_flash.ino
+  • Bench check that the step odometer survives totalizer checkpoints.
+    Runs the pump at a fixed rate and writes journal records back to
+    back through the real Totalizer, ring wrap and sector erases
+    included.  Across every service() call the odometer must advance
+    by rate × elapsed time; a masked wrap IRQ would drop edges and
+    show up as a shortfall of ≈ 110 1/32-steps per 45 ms erase.
+  • Prints one line per erase, then PASS / FAIL:
+        gaps n, page max µs, erase n / max µs, worst odo error
+  • Build with a ≥ 16 KB filesystem (Tools → Flash Size), otherwise
+    the journal falls back to EEPROM and nothing is checked.
+  • Adds CKPTS × TOTAL_CKPT_UL to the lifetime total: bench boards
+    only ("T CLR" on the firmware afterwards).
+
+  Wiring: the controller board as built; the motor may be unplugged
+  or the tubing removed, the driver only has to take the STEP pulses.
+*/
+
+#include <Arduino.h>
+#include "../../src/core/totalizer/totalizer.cpp"                 // unity build
+#include "../../src/devices/pump_drivers/drv8825/drv8825.cpp"
+
+/* ── test parameters ────────────────────────────────────────────────── */
+constexpr float    RATE_SPS = 2'540.0f;     // 1/32-steps/s ≈ 1000 µL/min, 1/32 mode
+constexpr uint32_t CKPTS    = (TOTAL_FLASH_SECTORS + 1) * 256u;   // one ring + a sector
+constexpr float    TOL      = 3.0f;         // 1/32-steps: edge phase at both ends
+constexpr uint32_t ERASE_US = 10'000;       // a longer gap was a sector erase
+
+void setup()
+{
+  Serial.begin(115200);
+  while (!Serial) {}
+
+  Totalizer::begin();
+  if (!Totalizer::gFlash) {
+    Serial.println(F("no 16 KB FS – journal in EEPROM, nothing to check"));
+    return;
+  }
+
+  PumpDrv::initPump();
+  float sps = PumpDrv::setSps(RATE_SPS);    // the rate the slice really runs
+  delay(200);                               // first edges, mode settled
+
+  uint32_t pageMax = 0, eraseMax = 0, erases = 0, gaps = 0;
+  float    worst   = 0.0f;
+  for (uint32_t k = 0; k < CKPTS; ++k) {
+    Totalizer::tick(TOTAL_CKPT_UL, 0, true);              // stage one record
+    for (;;) {                                            // record, then erase-ahead
+      uint32_t o0 = PumpDrv::stepCount(), t0 = micros();
+      bool     io = Totalizer::service(false);
+      uint32_t o1 = PumpDrv::stepCount(), t1 = micros();
+      if (!io) break;
+
+      float err = (o1 - o0) - sps * (t1 - t0) * 1e-6f;
+      if (fabsf(err) > fabsf(worst)) worst = err;
+      ++gaps;
+      if (t1 - t0 < ERASE_US) { pageMax = max(pageMax, t1 - t0); continue; }
+      ++erases;
+      eraseMax = max(eraseMax, t1 - t0);
+      Serial.print(F("erase ")); Serial.print(t1 - t0);
+      Serial.print(F(" us, odo error ")); Serial.println(err, 1);
+    }
+  }
+  PumpDrv::setSps(0);
+
+  Serial.print(F("gaps "));         Serial.print(gaps);
+  Serial.print(F(", page max "));   Serial.print(pageMax);
+  Serial.print(F(" us, erase "));   Serial.print(erases);
+  Serial.print(F(" / max "));       Serial.print(eraseMax);
+  Serial.print(F(" us, worst odo error ")); Serial.print(worst, 1);
+  Serial.println(F(" 1/32-steps"));
+  Serial.println(erases && fabsf(worst) <= TOL ? F("PASS") : F("FAIL"));
+}
+
+void loop() {}
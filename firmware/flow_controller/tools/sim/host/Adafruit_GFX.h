@@ -0,0 +1,6 @@
+#pragma once
+/*  Adafruit_GFX.h – host shim: the type, not the drawing */
+
+#include <Arduino.h>
+
+class Adafruit_GFX {};
@@ -0,0 +1,20 @@
+#pragma once
+/*  Adafruit_NeoPixel.h – host shim: the status LED goes nowhere */
+
+#include <Arduino.h>
+
+#define NEO_GRB    0
+#define NEO_KHZ800 0
+
+class Adafruit_NeoPixel {
+public:
+    Adafruit_NeoPixel(uint16_t, int16_t, int) {}
+    void begin()                            {}
+    void show()                             {}
+    bool canShow()                          { return true; }
+    void setBrightness(uint8_t)             {}
+    void setPixelColor(uint16_t, uint32_t)  {}
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b)
+    { return (uint32_t(r) << 16) | (uint32_t(g) << 8) | b; }
+    static uint32_t gamma32(uint32_t c)     { return c; }
+};
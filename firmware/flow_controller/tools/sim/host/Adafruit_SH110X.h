@@ -0,0 +1,10 @@
+#pragma once
+/*  Adafruit_SH110X.h – host shim: declared for Sh1107Display, never driven */
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+class Adafruit_SH1107 : public Adafruit_GFX {
+public:
+    Adafruit_SH1107(uint16_t, uint16_t, TwoWire*, int8_t, uint32_t = 400000, uint32_t = 100000) {}
+};
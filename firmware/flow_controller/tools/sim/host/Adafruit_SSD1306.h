@@ -0,0 +1,10 @@
+#pragma once
+/*  Adafruit_SSD1306.h – host shim: declared for Ssd1306Display, never driven */
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+    Adafruit_SSD1306(uint8_t, uint8_t, TwoWire*, int8_t) {}
+};
@@ -0,0 +1,95 @@
+#pragma once
+/*  Arduino.h – host shim for tools/sim
+ *  -----------------------------------
+ *  What the firmware modules under test touch: pin and clock calls,
+ *  Print / Stream and the serial ports.  Pins read as low, analog
+ *  inputs as 0; the clock is Host::nowUs, moved by the harness, so a
+ *  run does not depend on how fast the host is.  Serial output is
+ *  dropped unless Host::echo is set.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <algorithm>
+
+enum : uint8_t { D0, D1, D2, D3, D4, D5, D6, D7, D8, D9, D10, A0 = 26, A1, A2, A3 };
+enum : uint8_t { LOW = 0, HIGH = 1 };
+enum : uint8_t { INPUT, OUTPUT, INPUT_PULLUP, INPUT_PULLDOWN };
+
+#define constrain(x, lo, hi) ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+using std::min;
+using std::max;
+
+namespace Host {
+inline uint64_t nowUs = 0;          // simulated time
+inline bool     echo  = false;      // Serial → stdout
+}
+
+/* ─── clock and pins ─── */
+inline uint32_t micros()                  { return static_cast<uint32_t>(Host::nowUs); }
+inline uint32_t millis()                  { return static_cast<uint32_t>(Host::nowUs / 1000); }
+inline void     delay(uint32_t ms)        { Host::nowUs += ms * 1000ULL; }
+inline void     delayMicroseconds(uint32_t us) { Host::nowUs += us; }
+inline void     pinMode(uint8_t, uint8_t) {}
+inline void     digitalWrite(uint8_t, uint8_t) {}
+inline int      digitalRead(uint8_t)      { return LOW; }
+inline int      analogRead(uint8_t)       { return 0; }
+inline void     noInterrupts()            {}
+inline void     interrupts()              {}
+
+/* ─── flash strings are plain strings here ─── */
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+/* ─── Print / Stream ─── */
+class Print {
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+
+    size_t print(const char* s)               { size_t n = 0; while (*s) n += write(*s++); return n; }
+    size_t print(const __FlashStringHelper* s) { return print(reinterpret_cast<const char*>(s)); }
+    size_t print(char c)                      { return write(static_cast<uint8_t>(c)); }
+    size_t print(int v, int b = 10)           { return print(static_cast<long>(v), b); }
+    size_t print(unsigned v, int b = 10)      { return print(static_cast<unsigned long>(v), b); }
+    size_t print(long v, int b = 10)          { return b == 10 ? fmt("%ld", v) : fmt("%lx", v); }
+    size_t print(unsigned long v, int b = 10) { return b == 10 ? fmt("%lu", v) : fmt("%lx", v); }
+    size_t print(long long v, int = 10)       { return fmt("%lld", v); }
+    size_t print(unsigned long long v, int = 10) { return fmt("%llu", v); }
+    size_t print(double v, int d = 2)         { return fmt("%.*f", d, v); }
+
+    size_t println()                          { return print("\r\n"); }
+    template <class T> size_t println(T v)        { size_t n = print(v); return n + println(); }
+    template <class T> size_t println(T v, int d) { size_t n = print(v, d); return n + println(); }
+
+private:
+    template <class... A> size_t fmt(const char* f, A... a)
+    {
+        char b[32];
+        snprintf(b, sizeof b, f, a...);
+        return print(static_cast<const char*>(b));
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read()      { return -1; }
+    virtual int peek()      { return -1; }
+};
+
+class HardwareSerial : public Stream {
+public:
+    void   begin(unsigned long) {}
+    void   end()                {}
+    void   flush()              {}
+    explicit operator bool() const { return true; }
+    size_t write(uint8_t c) override { if (Host::echo) putchar(c); return 1; }
+};
+
+inline HardwareSerial Serial, Serial1, Serial2;
@@ -0,0 +1,24 @@
+#pragma once
+/*  EEPROM.h – host shim: a RAM image that commit() keeps as is */
+
+#include <Arduino.h>
+
+class EEPROMClass {
+public:
+    void   begin(size_t n)       { _n = n < sizeof _b ? n : sizeof _b; }
+    bool   commit()              { ++commits; return true; }
+    size_t length() const        { return _n; }
+    uint8_t read(int a) const    { return _b[a]; }
+    void   write(int a, uint8_t v) { _b[a] = v; }
+
+    template <class T> T& get(int a, T& t) const { memcpy(&t, _b + a, sizeof t); return t; }
+    template <class T> const T& put(int a, const T& t) { memcpy(_b + a, &t, sizeof t); return t; }
+
+    uint32_t commits = 0;
+
+private:
+    uint8_t _b[4096];
+    size_t  _n = 0;
+};
+
+inline EEPROMClass EEPROM;
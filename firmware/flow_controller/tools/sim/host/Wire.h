@@ -0,0 +1,19 @@
+#pragma once
+/*  Wire.h – host shim: an I²C bus with nothing on it */
+
+#include <Arduino.h>
+
+class TwoWire : public Stream {
+public:
+    void    begin()                        {}
+    void    end()                          {}
+    void    setClock(uint32_t)             {}
+    void    setSDA(uint8_t)                {}
+    void    setSCL(uint8_t)                {}
+    void    beginTransmission(uint8_t)     {}
+    uint8_t endTransmission(bool = true)   { return 2; }    // NACK
+    uint8_t requestFrom(uint8_t, uint8_t)  { return 0; }
+    size_t  write(uint8_t) override        { return 1; }
+};
+
+inline TwoWire Wire;
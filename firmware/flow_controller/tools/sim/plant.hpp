@@ -0,0 +1,80 @@
+#pragma once
+/*  plant.hpp – host model of pump, tubing and sensor for tools/sim
+ *  ---------------------------------------------------------------
+ *  • step()  — one control tick at a commanded 1/32-step rate:
+ *              advances the odometer (unless the drive is stalled)
+ *              and the flow at the sensor
+ *  • read()  — sensor flow, µL/min, with white noise
+ *
+ *  Flow at the sensor is the delivered rate through a first-order
+ *  tube compliance (tau_s).  delivery scales what the rollers push
+ *  through (1 = nominal, 0 = line blocked), leak adds flow that does
+ *  not come from the rollers (free flow), and shape(θ), mean 1, is
+ *  the volume of the step at rotor angle θ (revolutions, 0 … 1) for
+ *  roller ripple.  Noise is a fixed-seed xorshift, so every run of a
+ *  harness is identical.
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "../../src/include/config.hpp"         // UL_PER_STEP
+
+namespace Sim {
+
+struct Plant {
+    float tau_s    = 0.5f;          // tube compliance
+    float noise    = 2.0f;          // sensor noise, µL/min rms
+    float gain     = 1.0f;          // true / nominal volume per step
+    float delivery = 1.0f;          // share of the stroke that arrives
+    float leak     = 0.0f;          // µL/min not driven by the rollers
+    bool  stalled  = false;         // drive emits no pulses
+    float (*shape)(float rev) = nullptr;    // roller ripple, mean 1
+
+    uint32_t odo = 0;
+    float    q   = 0.0f;            // flow at the sensor
+
+    /* one tick; returns the odometer delta */
+    uint32_t step(double sps, float dt_s)
+    {
+        double n = stalled ? 0.0 : sps * dt_s;      // pulses this tick
+        float vol = static_cast<float>(n);          // in steps, × shape
+        if (shape && n > 0) {
+            constexpr int M = 16;                   // midpoint rule
+            vol = 0;
+            for (int i = 0; i < M; ++i) {
+                double at = fmod(_pos + (i + 0.5) * n / M, PULSES_PER_REV);
+                vol += shape(static_cast<float>(at / PULSES_PER_REV));
+            }
+            vol *= static_cast<float>(n / M);
+        }
+        _pos += n;
+        uint32_t d = static_cast<uint32_t>(static_cast<uint64_t>(_pos)) - odo;
+        odo += d;
+        float in = vol * UL_PER_STEP * gain * delivery * (60.0f / dt_s) + leak;
+        q += (in - q) * (dt_s / (tau_s + dt_s));
+        return d;
+    }
+
+    float read() { return q + noise * gauss(); }
+
+private:
+    double   _pos = 0.0;             // pulses, continuous
+    uint32_t _rng  = 0x2545F491u;
+
+    float uniform()
+    {
+        _rng ^= _rng << 13; _rng ^= _rng >> 17; _rng ^= _rng << 5;
+        return (_rng >> 8) * (1.0f / 16777216.0f);
+    }
+    float gauss()                   // Irwin–Hall, sd 1
+    {
+        float s = 0;
+        for (int i = 0; i < 12; ++i) s += uniform();
+        return s - 6.0f;
+    }
+};
+
+/* µL/min ↔ 1/32-steps/s through the real pulse geometry */
+inline double rateToSps(double uLmin) { return uLmin / 60.0 / UL_PER_STEP; }
+
+}   // namespace Sim
@@ -0,0 +1,18 @@
+#!/bin/sh
+# run.sh – build and run the host simulations (all, or those named)
+#
+#     ./run.sh                  every sim_*.cpp
+#     ./run.sh sim_occlusion    just one
+#
+# Each harness includes the module sources it tests and exits non-zero
+# when a case fails; so does this script.
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+mkdir -p build
+fail=0
+for s in ${*:-$(ls sim_*.cpp | sed 's/\.cpp$//')}; do
+    echo "── $s"
+    $CXX -std=c++17 -O2 -Wall -Ihost -o "build/$s" "$s.cpp" -lm &&
+        "./build/$s" || fail=1
+done
+exit $fail
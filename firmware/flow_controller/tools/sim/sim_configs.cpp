@@ -0,0 +1,110 @@
+/*  sim_configs.cpp – the plant-model configurations, built and timed
+ *  ----------------------------------------------------------------
+ *  The firmware instantiates only Build::Active; this harness builds
+ *  MinCtrl<Build::Simulated> and MinCtrl<Build::Replay> from the same
+ *  min_ctrl_loop.hpp, so neither can rot unnoticed, and runs each for
+ *  TICKS control ticks with the pump on:
+ *
+ *    Simulated   SimSensor + SimPump (devices/sim)
+ *    Replay      ReplaySensor on a synthetic 500 µL/min trace + SimPump
+ *
+ *  Each step() is timed on the host clock while the simulated clock
+ *  advances one LOOP_INTERVAL_MS per tick.  The figures are host CPU
+ *  time – a comparison between the configurations, not an RP2040
+ *  budget (that one is "B" on the board).
+ *
+ *  Pass: both run every tick and end within ±5 % of the set-point.
+ *
+ *      cd tools/sim && ./run.sh sim_configs
+ */
+
+#include <chrono>
+#include <cstdio>
+#include "../../src/ctrl/min_ctrl/min_ctrl_loop.hpp"
+
+#include "../../src/core/bubble_guard/bubble_guard.cpp"   // unity build
+#include "../../src/core/cal_curve/cal_curve.cpp"
+#include "../../src/core/dose/dose.cpp"
+#include "../../src/core/filter/filter.cpp"
+#include "../../src/core/flow_kf/flow_kf.cpp"
+#include "../../src/core/gain/gain.cpp"
+#include "../../src/core/grav_cal/grav_cal.cpp"
+#include "../../src/core/occlusion/occlusion.cpp"
+#include "../../src/core/pid/flow_pid.cpp"
+#include "../../src/core/pid/pid.cpp"
+#include "../../src/core/ripple/ripple.cpp"
+#include "../../src/core/sp_program/sp_program.cpp"
+#include "../../src/core/temp_comp/temp_comp.cpp"
+#include "../../src/core/tick_stats/tick_stats.cpp"
+#include "../../src/core/totalizer/totalizer.cpp"
+#include "../../src/core/volume_tracker/volume_tracker.cpp"
+#include "../../src/devices/RGB/rgb.cpp"
+#include "../../src/devices/balance/balance.cpp"
+#include "../../src/devices/sim/sim.cpp"
+#include "../../src/include/system_state/system_state.cpp"
+#include "../../src/utils/serial/serial_cmd/serial_cmd.cpp"
+#include "../../src/utils/serial/serial_rpt/serial_rpt.cpp"
+
+template class MinCtrl<Build::Simulated>;
+template class MinCtrl<Build::Replay>;
+
+constexpr uint32_t TICKS  = 20000;              // 200 s at 100 Hz
+constexpr uint32_t DT_US  = LOOP_INTERVAL_MS * 1000UL;
+constexpr float    SP     = 500.0f;             // µL/min
+constexpr size_t   TRACE  = 1000;               // replay samples, looped
+
+/* serial_cmd reaches the running loop through these; here it is Simulated */
+static MinCtrl<Build::Simulated> gSim;
+static MinCtrl<Build::Replay>    gReplay;
+
+TickStats&  ctrlTickStats()    { return gSim.ticks(); }
+FlowKalman& ctrlKalman()       { return gSim.kalman(); }
+bool        ctrlRequestBench() { return false; }
+
+/* setup() and TICKS ticks of step(), each timed on the host clock */
+template <class Ctrl>
+static bool run(const char* name, Ctrl& c)
+{
+    using Clock = std::chrono::steady_clock;
+
+    c.setup();
+    State::setSetpoint(SP);
+    State::setPumpEnabled(true);
+
+    double   sum = 0, worst = 0;
+    uint32_t n   = 0;
+    for (uint32_t i = 0; i < TICKS; ++i) {
+        Host::nowUs += DT_US;
+        auto t0 = Clock::now();
+        c.step(State::nowUs());
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+        sum += us; if (us > worst) worst = us;
+        ++n;
+    }
+
+    float q  = g_state.f_flow;
+    bool  ok = n == TICKS && fabsf(q - SP) < 0.05f * SP;
+    printf("%-10s %6u B  %6u  %7.2f  %7.2f  %8.1f  %s\n", name,
+           static_cast<unsigned>(sizeof(Ctrl)), static_cast<unsigned>(n),
+           sum / n, worst, q, ok ? "pass" : "FAIL");
+    State::setPumpEnabled(false);
+    return ok;
+}
+
+int main()
+{
+    static float trace[TRACE];
+    uint32_t seed = 1;
+    for (size_t i = 0; i < TRACE; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        trace[i] = SP + ((seed >> 8) / 16777216.0f - 0.5f) * 2.0f * KF_R_FLOW_SD;
+    }
+    gReplay.sensor().attach(trace, nullptr, TRACE);
+
+    printf("config        RAM   ticks  mean µs   max µs  flow µL/min\n");
+    int fails = 0;
+    fails += !run("Simulated", gSim);
+    fails += !run("Replay",    gReplay);
+    printf("%d case(s) failed (host CPU time, not RP2040)\n", fails);
+    return fails ? 1 : 0;
+}
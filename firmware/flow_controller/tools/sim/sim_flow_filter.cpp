@@ -0,0 +1,103 @@
+/*  sim_flow_filter.cpp – host cases for the flow filter chain
+ *  ----------------------------------------------------------
+ *  Sim::Plant with 12 % roller ripple (6 half-sine dips per rev),
+ *  15 ms of tubing + sensor lag and 1 % sensor noise, filtered by
+ *    old : 0.25 Hz 4th-order Butterworth, no notches
+ *    new : tuneHarmonics() bank on f_roll … 4·f_roll, then the
+ *          FLOW_LPF_HZ Butterworth – the chain min_ctrl runs
+ *  Per rate, after settling: residual peak-to-peak of the output
+ *  over STEADY_S, then t90 after a +10 % rate step.
+ *
+ *  Pass: new t90 below old t90, and new residual under RESID_MAX.
+ *
+ *      cd tools/sim && ./run.sh sim_flow_filter
+ */
+
+#include <cstdio>
+#include "plant.hpp"
+#include "../../src/core/filter/notch.hpp"
+#include "../../src/core/filter/biquad.hpp"
+
+constexpr float FS_HZ     = 1000.0f / LOOP_INTERVAL_MS;
+constexpr float DT_S      = 1.0f / FS_HZ;
+constexpr float SETTLE_S  = 30.0f;
+constexpr float STEADY_S  = 10.0f;
+constexpr float STEP_S    = 10.0f;
+constexpr float RESID_MAX = 1.5f;           // % p-p
+
+static float rollers(float rev)
+{
+    float dip = fabsf(sinf(float(M_PI) * ROLLERS * rev)) - 2.0f / float(M_PI);
+    return 1.0f - 0.12f * dip;
+}
+
+struct Chain {
+    bool   notch;
+    BiQuad a, b;
+    Notch  bank[NOTCH_HARMONICS];
+
+    Chain(bool n, float fc)
+        : notch(n), a(BiQuad::lowpass(fc, FS_HZ, 1.30656f)),
+          b(BiQuad::lowpass(fc, FS_HZ, 0.54120f)) {}
+
+    float operator()(float x, double sps)
+    {
+        if (notch) {
+            float fr = static_cast<float>(sps) * ROLLERS / RIPPLE_STEPS_PER_REV;
+            tuneHarmonics(bank, NOTCH_HARMONICS, fr, FS_HZ, NOTCH_Q, NOTCH_MIN_HZ, NOTCH_MAX_HZ);
+            for (Notch& n : bank) x = n(x);
+        }
+        return b(a(x));
+    }
+};
+
+struct Result { float resid_pct, t90_s; };
+
+static Result run(float sp, bool notch, float fc)
+{
+    Sim::Plant p;
+    p.tau_s = 0.015f;
+    p.noise = 0.01f * sp;
+    p.shape = rollers;
+    Chain f(notch, fc);
+
+    double sps = Sim::rateToSps(sp);
+    float  y = 0, lo = 1e30f, hi = -1e30f;
+    double sum = 0;
+    long   n = 0, k = 0;
+    for (; k * DT_S < SETTLE_S + STEADY_S; ++k) {
+        y = f(p.read(), sps);
+        p.step(sps, DT_S);
+        if (k * DT_S < SETTLE_S) continue;
+        lo = fminf(lo, y); hi = fmaxf(hi, y); sum += y; ++n;
+    }
+    float y0 = static_cast<float>(sum / n);
+
+    /* +10 %: t90 is the first time the output reaches y0 + 0.9·Δ */
+    sps *= 1.1;
+    float target = y0 * 1.09f, t90 = -1.0f;
+    for (long j = 0; j * DT_S < STEP_S; ++j) {
+        y = f(p.read(), sps);
+        p.step(sps, DT_S);
+        if (y >= target) { t90 = (j + 1) * DT_S; break; }
+    }
+    return {(hi - lo) / y0 * 100.0f, t90};
+}
+
+int main()
+{
+    int fails = 0;
+    printf("µL/min  f_roll    t90 old → new      residual p-p old → new\n");
+    static const float RATES[] = {200, 600, 1000, 1400, 1800};
+    for (float sp : RATES) {
+        Result o = run(sp, false, 0.25f);
+        Result w = run(sp, true,  FLOW_LPF_HZ);
+        float fr = static_cast<float>(Sim::rateToSps(sp)) * ROLLERS / RIPPLE_STEPS_PER_REV;
+        bool ok = w.t90_s > 0 && (o.t90_s < 0 || w.t90_s < o.t90_s) && w.resid_pct < RESID_MAX;
+        fails += !ok;
+        printf("%6.0f  %.2f Hz  %5.2f s → %5.2f s   %5.2f %% → %5.2f %%  %s\n",
+               sp, fr, o.t90_s, w.t90_s, o.resid_pct, w.resid_pct, ok ? "pass" : "FAIL");
+    }
+    printf("%d rate(s) failed\n", fails);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+/*  sim_flow_kf.cpp – host cases for the step / sensor fusion
+ *  ---------------------------------------------------------
+ *  Sim::Plant at 1000 µL/min with a true volume per step 7 % under
+ *  nominal (gain 0.93), τ = KF_TAU_S and KF_R_FLOW_SD sensor noise.
+ *  FlowKalman is fed the commanded steps and the sensor, as min_ctrl
+ *  does (kR = 1 here); the reference is the FLOW_LPF_HZ Butterworth
+ *  on the same samples.
+ *
+ *    gain      k̂ after CONVERGE_S                 within GAIN_TOL
+ *    step      t90 after a commanded +10 % step    KF ≤ LPF
+ *    drop      t90 after an unmodelled −10 % drop  KF ≤ LPF
+ *    noise     output SD in steady state           KF ≤ LPF
+ *
+ *      cd tools/sim && ./run.sh sim_flow_kf
+ */
+
+#include <cstdio>
+#include "plant.hpp"
+#include "../../src/core/flow_kf/flow_kf.cpp"         // unity build
+#include "../../src/core/filter/biquad.hpp"
+
+constexpr float    FS_HZ      = 1000.0f / LOOP_INTERVAL_MS;
+constexpr float    DT_S       = 1.0f / FS_HZ;
+constexpr uint32_t DT_US      = LOOP_INTERVAL_MS * 1000UL;
+constexpr float    SP         = 1000.0f;
+constexpr float    K_TRUE     = 0.93f;
+constexpr float    CONVERGE_S = 10.0f;
+constexpr float    GAIN_TOL   = 0.01f;
+
+struct Loop {
+    Sim::Plant p;
+    FlowKalman kf;
+    BiQuad     a = BiQuad::lowpass(FLOW_LPF_HZ, FS_HZ, 1.30656f);
+    BiQuad     b = BiQuad::lowpass(FLOW_LPF_HZ, FS_HZ, 0.54120f);
+    double     sps = Sim::rateToSps(SP);
+    float      kfOut = 0, lpOut = 0;
+
+    Loop() { p.tau_s = KF_TAU_S; p.noise = KF_R_FLOW_SD; p.gain = K_TRUE; }
+
+    void tick()
+    {
+        float z = p.read();
+        kf.update(static_cast<float>(sps * UL_PER_STEP * 60.0), z, DT_US);
+        kfOut = kf.flow();
+        lpOut = b(a(z));
+        p.step(sps, DT_S);
+    }
+    void run(float s) { for (long k = 0; k * DT_S < s; ++k) tick(); }
+};
+
+/* t90 of both estimates for a change applied by `apply` */
+template <class F>
+static void t90(Loop& L, F apply, float& tKf, float& tLp, float& tPlant)
+{
+    float y0 = L.p.q, y1;
+    apply(L);
+    { Loop M = L; M.p.noise = 0; M.run(10.0f); y1 = M.p.q; }   // where it settles
+    float th = y0 + 0.9f * (y1 - y0);
+    bool  up = y1 > y0;
+    tKf = tLp = tPlant = -1.0f;
+    for (long k = 1; k * DT_S < 10.0f; ++k) {
+        L.tick();
+        float t = k * DT_S;
+        if (tKf    < 0 && (up ? L.kfOut >= th : L.kfOut <= th)) tKf = t;
+        if (tLp    < 0 && (up ? L.lpOut >= th : L.lpOut <= th)) tLp = t;
+        if (tPlant < 0 && (up ? L.p.q   >= th : L.p.q   <= th)) tPlant = t;
+    }
+}
+
+int main()
+{
+    int fails = 0;
+    Loop L;
+
+    L.run(CONVERGE_S);
+    bool ok = fabsf(L.kf.gain() - K_TRUE) < GAIN_TOL;
+    fails += !ok;
+    printf("gain    k̂ %.3f ± %.3f after %.0f s (true %.2f), vpr %.2f µL/rev  %s\n",
+           L.kf.gain(), sqrtf(L.kf.gainVar()), CONVERGE_S, K_TRUE, L.kf.vpr(),
+           ok ? "pass" : "FAIL");
+
+    L.run(10.0f);
+    double s = 0, s2 = 0, l = 0, l2 = 0; long n = 0;
+    for (long k = 0; k * DT_S < 10.0f; ++k, ++n) {
+        L.tick();
+        double e = L.kfOut - L.p.q, f = L.lpOut - L.p.q;
+        s += e; s2 += e * e; l += f; l2 += f * f;
+    }
+    double sdKf = sqrt(s2 / n - (s / n) * (s / n)), sdLp = sqrt(l2 / n - (l / n) * (l / n));
+    ok = sdKf <= sdLp;
+    fails += !ok;
+    printf("noise   output SD KF %.2f, LPF %.2f µL/min (sensor %.1f)  %s\n",
+           sdKf, sdLp, KF_R_FLOW_SD, ok ? "pass" : "FAIL");
+
+    float a, b, c;
+    t90(L, [](Loop& M) { M.sps *= 1.1; }, a, b, c);
+    ok = a > 0 && b > 0 && a <= b;
+    fails += !ok;
+    printf("step    t90 KF %.2f s, LPF %.2f s, plant %.2f s  %s\n", a, b, c, ok ? "pass" : "FAIL");
+
+    L.run(10.0f);
+    t90(L, [](Loop& M) { M.p.delivery = 0.9f; }, a, b, c);
+    ok = a > 0 && b > 0 && a <= b;
+    fails += !ok;
+    printf("drop    t90 KF %.2f s, LPF %.2f s, plant %.2f s  %s\n", a, b, c, ok ? "pass" : "FAIL");
+
+    printf("%d case(s) failed\n", fails);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+/*  sim_flow_pid.cpp – host cases for the closed flow loop
+ *  ------------------------------------------------------
+ *  The min_ctrl control path on Sim::Plant (τ = KF_TAU_S,
+ *  KF_R_FLOW_SD noise): FlowKalman feedback, FlowPid with ff = sp/k̂,
+ *  nominal steps = u / kR, track() on the rate actually run.
+ *
+ *    enable    pump off 10 s, then on at 500 µL/min
+ *    re-enable 1000 µL/min, switched off during a sensor dropout,
+ *              on again 5 s later at 300: nothing of the old run's
+ *              integrator or held output may carry over
+ *    cap       1000 µL/min, output capped at 600 for 5 s, released
+ *    kR        delivery drops 15 % with temperature at 800 µL/min:
+ *              TempComp's kR following it, against kR = 1 (all of it
+ *              left to k̂ and the PID)
+ *
+ *  Pass: overshoot under OVERSHOOT_MAX and within ±2 % after at most
+ *  SETTLE_MAX on enable, re-enable and release; with kR following, k̂ stays
+ *  within 0.02 of 1 (it learns only the residual) and the 3 s after
+ *  the drop carry less than half the error of kR = 1.
+ *
+ *      cd tools/sim && ./run.sh sim_flow_pid
+ */
+
+#include <cstdio>
+#include "plant.hpp"
+#include "../../src/core/flow_kf/flow_kf.cpp"         // unity build
+#include "../../src/core/pid/flow_pid.cpp"
+
+constexpr float    DT_S          = LOOP_INTERVAL_MS / 1000.0f;
+constexpr uint32_t DT_US         = LOOP_INTERVAL_MS * 1000UL;
+constexpr float    OVERSHOOT_MAX = 5.0f;        // %
+constexpr float    SETTLE_MAX    = 2.0f;        // s
+
+struct Loop {
+    Sim::Plant p;
+    FlowKalman kf;
+    FlowPid    pid{{FLOW_PID_KP, FLOW_PID_KI, FLOW_PID_KD},
+                   FLOW_PID_OUT_MIN, FLOW_PID_OUT_MAX, PID_REF_TAU_S, PID_TRACK_S};
+    float  kR = 1.0f, sp = 0, cap = 1e9f;
+    bool   on = false, was = false, held = false;   // held: bad sample, output held
+    double sps = 0;
+
+    Loop(float plantGain = 0.93f)
+    {
+        p.tau_s = KF_TAU_S; p.noise = KF_R_FLOW_SD; p.gain = plantGain;
+    }
+
+    void tick()
+    {
+        float z = p.read();
+        kf.update(static_cast<float>(sps * UL_PER_STEP * 60.0) * kR, z, DT_US);
+        float y = kf.flow();
+        if (on) {
+            if (!was) pid.start(y);
+            float u = pid.output();
+            if (held) pid.hold(u);
+            else      u = pid.compute(sp, y, sp / kf.gain(), DT_S);
+            sps = Sim::rateToSps((u < cap ? u : cap) / kR);
+            pid.track(static_cast<float>(sps * UL_PER_STEP * 60.0) * kR, DT_S);
+        } else {
+            sps = 0;
+        }
+        was = on;
+        p.step(sps, DT_S);
+    }
+    void run(float s) { for (long k = 0; k * DT_S < s; ++k) tick(); }
+};
+
+/* overshoot (%) and time to stay within ±2 % of sp, over `span` s */
+static void response(Loop& L, float span, float& over, float& settle)
+{
+    float peak = 0;
+    settle = 0;
+    for (long k = 1; k * DT_S < span; ++k) {
+        L.tick();
+        float q = L.p.q;
+        if (q > peak) peak = q;
+        if (fabsf(q - L.sp) > 0.02f * L.sp) settle = k * DT_S;
+    }
+    over = (peak - L.sp) / L.sp * 100.0f;
+}
+
+static bool report(const char* what, float over, float settle)
+{
+    bool ok = over < OVERSHOOT_MAX && settle <= SETTLE_MAX;
+    printf("%-9s overshoot %5.2f %%, within 2 %% after %.2f s  %s\n",
+           what, over, settle, ok ? "pass" : "FAIL");
+    return ok;
+}
+
+/* a temperature change drops the delivery 15 % at 800 µL/min; mean
+   |error| over the 3 s after it, and k̂ once settled               */
+static float tempStep(Loop& L, bool known, float* kHat)
+{
+    L.sp = 800; L.on = true;
+    L.run(20.0f);
+    L.p.gain = 0.85f;
+    if (known) L.kR = 0.85f;                        // TempComp tracks it
+    double e = 0; long n = 0;
+    for (long k = 0; k * DT_S < 3.0f; ++k, ++n) { L.tick(); e += fabsf(L.p.q - L.sp); }
+    L.run(10.0f);
+    *kHat = L.kf.gain();
+    return static_cast<float>(e / n);
+}
+
+int main()
+{
+    int fails = 0;
+    float over, settle;
+
+    {   Loop L;
+        L.sp = 500; L.run(10.0f);                   // off, sp already set
+        L.on = true;
+        response(L, 15.0f, over, settle);
+        fails += !report("enable", over, settle);
+    }
+    {   Loop L;
+        L.sp = 1000; L.on = true; L.run(15.0f);
+        L.held = true; L.run(0.5f);                 // switched off in a dropout
+        L.on = false;  L.run(5.0f);
+        L.held = false;
+        L.sp = 300;    L.on = true;
+        response(L, 15.0f, over, settle);
+        fails += !report("re-enable", over, settle);
+    }
+    {   Loop L;
+        L.sp = 1000; L.on = true; L.run(15.0f);
+        L.cap = 600; L.run(5.0f);
+        L.cap = 1e9f;
+        response(L, 15.0f, over, settle);
+        fails += !report("cap", over, settle);
+    }
+    {   Loop known(1.0f), blind(1.0f);
+        float kK, kB;
+        float eK = tempStep(known, true,  &kK);
+        float eB = tempStep(blind, false, &kB);
+        bool ok = fabsf(kK - 1.0f) < 0.02f && eK < 0.5f * eB;
+        fails += !ok;
+        printf("kR        −15 %% delivery: mean |e| %.1f (kR follows) vs %.1f (kR = 1) µL/min, "
+               "k̂ %.3f vs %.3f  %s\n", eK, eB, kK, kB, ok ? "pass" : "FAIL");
+    }
+
+    printf("%d case(s) failed\n", fails);
+    return fails ? 1 : 0;
+}
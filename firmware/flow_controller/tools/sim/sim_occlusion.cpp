@@ -0,0 +1,106 @@
+/*  sim_occlusion.cpp – host cases for the delivery monitor
+ *  -------------------------------------------------------
+ *  Drives OcclusionDetector with Sim::Plant at 100 Hz.  Each case
+ *  runs the pump at a set-point, applies a fault at FAULT_S and
+ *  checks the verdict that follows within exactly the bound stated in
+ *  config.hpp – window + hold, plus the blanking when the fault comes
+ *  with a commanded stop – and that no other fault fires:
+ *
+ *    nominal        no fault                       → OK, no event
+ *    partial        40 % of the stroke arrives      → OCCLUDED
+ *    blocked        nothing arrives, pulses go on   → OCCLUDED
+ *    stalled        no pulses, sensor sees nothing  → STALLED
+ *    free flow      pump off, 100 µL/min leak       → FREE_FLOW
+ *    rate step      500 → 1500 µL/min set-point     → OK, no event
+ *
+ *      cd tools/sim && ./run.sh sim_occlusion
+ */
+
+#include <cstdio>
+#include "plant.hpp"
+#include "../../src/core/occlusion/occlusion.cpp"     // unity build
+
+using OS = OcclusionDetector::State;
+
+static const char* name(OS s)
+{
+    static const char* const N[] = {"OK", "OCCLUDED", "STALLED", "FREE_FLOW"};
+    return N[static_cast<uint8_t>(s)];
+}
+
+constexpr uint32_t DT_US   = LOOP_INTERVAL_MS * 1000UL;
+constexpr float    FAULT_S = 10.0f;
+constexpr float    END_S   = 20.0f;
+constexpr float    BLOCK_S = OCCL_BLOCK_TICKS * LOOP_INTERVAL_MS / 1000.0f;
+constexpr float    LATE_S  = (OCCL_BLOCKS + OCCL_HOLD_BLOCKS) * BLOCK_S;
+constexpr float    BLANK_S = OCCL_SETTLE_BLOCKS * BLOCK_S;   // a commanded step
+
+enum class Fault { NONE, PARTIAL, BLOCKED, STALLED, FREE_FLOW, RATE_STEP };
+
+struct Case { const char* what; Fault f; float sp; OS want; };
+
+static bool run(const Case& c)
+{
+    Sim::Plant        p;
+    OcclusionDetector od;
+    float  sp = c.sp;
+    bool   pumping = true;
+    float  hit = -1.0f;                 // first tick in the wanted state
+    OS     wrong = OS::OK;              // any other non-OK verdict
+
+    for (uint32_t k = 0; k * DT_US < END_S * 1e6f; ++k) {
+        float t = k * DT_US * 1e-6f;
+        if (t >= FAULT_S) {
+            switch (c.f) {
+                case Fault::PARTIAL:   p.delivery = 0.4f;             break;
+                case Fault::BLOCKED:   p.delivery = 0.0f;             break;
+                case Fault::STALLED:   p.stalled  = true;             break;
+                case Fault::FREE_FLOW: pumping = false; p.leak = 100; break;
+                case Fault::RATE_STEP: sp = 1500.0f;                  break;
+                case Fault::NONE:                                     break;
+            }
+        }
+        double sps = pumping ? Sim::rateToSps(sp) : 0.0;
+        uint32_t d = p.step(sps, DT_US * 1e-6f);
+
+        Sample s;
+        s.value = p.read();
+        od.update(static_cast<float>(sps), d, s, DT_US);
+
+        OS st = od.state();
+        if (st == c.want && st != OS::OK && hit < 0) hit = t;
+        if (st != c.want && st != OS::OK) wrong = st;
+    }
+
+    bool ok;
+    if (c.want == OS::OK) {
+        ok = od.events() == 0 && od.state() == OS::OK;
+        printf("%-10s  %-9s  events %u  ratio %.2f  %s\n", c.what, name(od.state()),
+               od.events(), od.ratio(), ok ? "pass" : "FAIL");
+    } else {
+        float lat = hit >= 0 ? hit - FAULT_S : -1.0f;
+        float lim = LATE_S + (c.f == Fault::FREE_FLOW ? BLANK_S : 0.0f);
+        ok = hit >= FAULT_S && lat <= lim && wrong == OS::OK;
+        printf("%-10s  %-9s  after %.2f s  ratio %.2f%s  %s\n", c.what, name(od.state()),
+               lat, od.ratio(), wrong != OS::OK ? "  (also saw another fault)" : "",
+               ok ? "pass" : "FAIL");
+    }
+    return ok;
+}
+
+int main()
+{
+    static const Case CASES[] = {
+        {"nominal",   Fault::NONE,      1000, OS::OK},
+        {"partial",   Fault::PARTIAL,   1000, OS::OCCLUDED},
+        {"blocked",   Fault::BLOCKED,   1000, OS::OCCLUDED},
+        {"stalled",   Fault::STALLED,   1000, OS::STALLED},
+        {"free flow", Fault::FREE_FLOW, 1000, OS::FREE_FLOW},
+        {"rate step", Fault::RATE_STEP,  500, OS::OK},
+    };
+    int fails = 0;
+    for (const Case& c : CASES) fails += !run(c);
+    printf("%d of %zu cases failed (limit %.2f s, +%.2f s after a pump stop)\n",
+           fails, sizeof(CASES) / sizeof(CASES[0]), LATE_S, BLANK_S);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,44 @@
+/*  step_timing_table.cpp – host check of the STEP period synthesis
+ *  ---------------------------------------------------------------
+ *  Worst-case relative rate error per decade of step rate, for
+ *    before : fixed 125 MHz / 8, phase-correct, TOP clamped to
+ *             [1, 65535] (the old Hal::spsToTop model)
+ *    after  : Hal::spsToTiming(), 8.4 divider and TOP chosen jointly
+ *  A rate outside the reachable range counts as its clamped rate.
+ *
+ *      g++ -std=c++17 -O2 -o step_timing_table step_timing_table.cpp
+ *      ./step_timing_table
+ */
+
+#include <cstdio>
+#include <cmath>
+#include "../src/devices/hal/step_timing.hpp"
+
+static double before(double sps)
+{
+    constexpr double CLK = 125'000'000.0 / 8.0;
+    double top = CLK / (2.0 * sps) - 1.0;
+    if (top < 1)     top = 1;
+    if (top > 65535) top = 65535;
+    uint16_t t = static_cast<uint16_t>(top);
+    return CLK / (2.0 * (t + 1));
+}
+
+static double after(double sps) { return Hal::timingToSps(Hal::spsToTiming(sps)); }
+
+int main()
+{
+    std::printf("%-22s %14s %14s\n", "steps/s", "before ppm", "after ppm");
+    for (double lo = 1.0; lo < 1e6; lo *= 10.0) {
+        double wb = 0, wa = 0;
+        for (int i = 0; i < 20000; ++i) {
+            double s = lo * std::pow(10.0, i / 20000.0);
+            wb = std::fmax(wb, std::fabs(before(s) / s - 1.0));
+            wa = std::fmax(wa, std::fabs(after(s)  / s - 1.0));
+        }
+        std::printf("%8.0f … %-10.0f %14.1f %14.1f\n", lo, lo * 10, wb * 1e6, wa * 1e6);
+    }
+    std::printf("lowest rate: before %.2f /s, after %.2f /s\n",
+                before(1e-3), after(1e-3));
+    return 0;
+}
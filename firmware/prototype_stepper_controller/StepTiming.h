@@ -0,0 +1,41 @@
+#pragma once
+/* StepTiming.h – STEP period for an RP2040 PWM slice, integer only
+ *
+ * The slice runs edge-aligned: one period is (TOP+1) counts of
+ * sys_clk / (div16/16), div16 being the 8.4 clock divider.  The
+ * divider is the smallest that fits the period in 16 bits, so TOP
+ * keeps ≥ 32768 counts below ≈ sys_clk/32768 and the rate error
+ * stays under 16 ppm there (under 1/(2·TOP) above).  One 32-bit
+ * divide per call: callers only ask when the rate changes.        */
+
+#include <stdint.h>
+
+struct StepTiming {
+    uint16_t top   = 0;
+    uint16_t div16 = 16;                 // 8.4 fixed point, 1.0 … 255.9375
+};
+
+constexpr uint16_t STEP_DIV16_MIN = 16;
+constexpr uint16_t STEP_DIV16_MAX = 0xFFF;
+
+/* clk16 = sys_clk · 16 (fits 32 bits up to 268 MHz), sps > 0 */
+inline StepTiming stepTiming(uint32_t clk16, uint32_t sps)
+{
+    uint32_t c16 = clk16 / sps;                     // period, 1/16 sys_clk
+    uint32_t div = (c16 + 0xFFFF) >> 16;            // ceil(c16 / 65536)
+    if (div < STEP_DIV16_MIN) div = STEP_DIV16_MIN;
+    if (div > STEP_DIV16_MAX) div = STEP_DIV16_MAX;
+    uint32_t top1 = (c16 + div / 2) / div;
+    if (top1 < 2)       top1 = 2;
+    if (top1 > 0x10000) top1 = 0x10000;
+    StepTiming t;
+    t.top   = static_cast<uint16_t>(top1 - 1);
+    t.div16 = static_cast<uint16_t>(div);
+    return t;
+}
+
+/* rate a timing actually produces, in mHz (host checks, status) */
+inline uint64_t stepTimingMilliHz(uint32_t clk16, StepTiming t)
+{
+    return (uint64_t(clk16) * 1000u) / (uint64_t(t.div16) * (t.top + 1u));
+}
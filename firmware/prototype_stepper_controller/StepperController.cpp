@@ -1,6 +1,16 @@
 #include "StepperController.h"
 #include <EEPROM.h>
 #include <math.h>          // isfinite()
+#include "hardware/pwm.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+
+static StepperController* sSelf = nullptr;     // owner of the wrap ISR
+
+static __force_inline void setDiv(uint32_t slice, uint16_t div16)
+{
+    pwm_set_clkdiv_int_frac(slice, div16 >> 4, div16 & 0xF);
+}
 
 /* ------------------------------------------------------------------ */
 /*  Constructor                                                       */
@@ -14,7 +24,7 @@ StepperController::StepperController(uint8_t stepPin,
 {}
 
 /* ------------------------------------------------------------------ */
-/*  begin() – init driver and load saved RPM                          */
+/*  begin() – init driver, PWM slice and load saved RPM               */
 /* ------------------------------------------------------------------ */
 void StepperController::begin(uint16_t stepsPerRev, uint8_t microstep)
 {
@@ -22,7 +32,21 @@ void StepperController::begin(uint16_t stepsPerRev, uint8_t microstep)
     _microstep   = microstep;
 
     _drv.begin(_dirPin, _stepPin, _enPin, 255, 255);
-    _drv.enable();
+    _drv.setDirection(_prevDir);
+    enable();
+
+    /* STEP from a PWM slice; wrap IRQ counts the edges */
+    sSelf  = this;
+    _clk16 = clock_get_hz(clk_sys) * 16u;
+    _slice = pwm_gpio_to_slice_num(_stepPin);
+    pwm_config cfg = pwm_get_default_config();       // edge-aligned, level 0
+    pwm_init(_slice, &cfg, false);
+    gpio_set_function(_stepPin, GPIO_FUNC_PWM);
+
+    pwm_clear_irq(_slice);
+    pwm_set_irq_enabled(_slice, true);
+    irq_set_exclusive_handler(PWM_IRQ_WRAP, onWrap);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
 
     /* load last RPM from EEPROM (4-byte float) */
     EEPROM.begin(sizeof(float));
@@ -30,25 +54,37 @@ void StepperController::begin(uint16_t stepsPerRev, uint8_t microstep)
     EEPROM.get(EEPROM_ADDR_RPM, tmp);
     if (!isfinite(tmp) || tmp < 1.0f || tmp > 1200.0f) tmp = 60.0f;
 
-    _rpmTarget = _rpmActual = tmp;
-    recomputeIntervals();
+    _rpmTarget = tmp;
+    _spsTarget = rpmToSps(_rpmTarget);
+    _spsStart  = rpmToSps(1.0f);
+    _accelSps2 = lroundf(_accelRpmPerSec * _stepsPerRev * _microstep / 60.0f);
+    _lastTick  = micros();
 }
 
 /* ------------------------------------------------------------------ */
-void StepperController::recomputeIntervals()
+/*  rpm → integer steps/s, within what the slice and driver can do    */
+/* ------------------------------------------------------------------ */
+uint32_t StepperController::rpmToSps(float rpm) const
 {
-    float µsPerStep = 60.0f * 1e6f / (_rpmTarget * _stepsPerRev * _microstep);
-    _intTargetUs    = (uint32_t)µsPerStep;
-    if (_intTargetUs == 0) _intTargetUs = 1;
+    float s = rpm * _stepsPerRev * _microstep / 60.0f;
+    if (s > STEP_MAX_HZ) s = STEP_MAX_HZ;
+    uint32_t sps  = lroundf(s);
+    uint32_t slow = _clk16 / (uint32_t(STEP_DIV16_MAX) << 16) + 1;
+    return sps > slow ? sps : slow;
 }
 
 /* ------------------------------------------------------------------ */
 void StepperController::setRPM(float rpmTarget)
 {
     _rpmTarget = constrain(rpmTarget, 1.0f, 1200.0f);
-    recomputeIntervals();
-    EEPROM.put(EEPROM_ADDR_RPM, _rpmTarget);
-    EEPROM.commit();
+    _spsTarget = rpmToSps(_rpmTarget);
+    _rpmDirty  = true;          // flash write stalls the ISR: not while moving
+}
+
+float StepperController::getRPMActual() const
+{
+    if (_phase != Phase::Run) return 0.0f;
+    return _sps * 60.0f / (_stepsPerRev * _microstep);
 }
 
 /* ------------------------------------------------------------------ */
@@ -59,51 +95,171 @@ void StepperController::runContinuous(bool on, bool cw)
 }
 
 /* ------------------------------------------------------------------ */
-void StepperController::moveRelative(long steps) { _target += steps; }
+void StepperController::moveRelative(long steps)
+{
+    _target  += steps;
+    _braking  = false;          // decel point moved
+}
+
+/* ------------------------------------------------------------------ */
+void StepperController::disable()
+{
+    halt();
+    _drv.disable();
+    _enabled = false;
+}
+
+/* ------------------------------------------------------------------ */
+/*  PWM wrap ISR – one call per STEP rising edge; runs from RAM, so   */
+/*  an XIP cache miss cannot stretch it past the next wrap            */
+/* ------------------------------------------------------------------ */
+void __not_in_flash_func(StepperController::onWrap)()
+{
+    StepperController& m = *sSelf;
+    pwm_clear_irq(m._slice);
+    if (m._divWraps && --m._divWraps == 0) setDiv(m._slice, m._divArm);
+
+    long p = m._pos + m._dirStep;
+    m._pos = p;
+    if (!m._runForever && p == m._target) {   // output holds high: no extra edge
+        pwm_set_enabled(m._slice, false);
+        m._running = false;
+    }
+}
 
 /* ------------------------------------------------------------------ */
-/*  service()  – non-blocking step engine                             */
+/*  Slice control                                                     */
+/* ------------------------------------------------------------------ */
+void StepperController::start()
+{
+    _sps     = _spsStart;
+    _rampRem = 0;
+    _braking = false;
+    _dirStep = _prevDir ? 1 : -1;
+
+    /* idle: everything applies at once; counter pre-loaded so the
+       first rising edge lands on a wrap                            */
+    StepTiming t = stepTiming(_clk16, _sps);
+    uint16_t   h = (t.top + 1u) / 2;                // 50 % duty
+    noInterrupts();
+    _divWraps = 0;
+    setDiv(_slice, t.div16);
+    pwm_set_wrap(_slice, t.top);
+    pwm_set_gpio_level(_stepPin, h);
+    pwm_set_counter(_slice, h);
+    _cur     = t;
+    _running = true;
+    pwm_set_enabled(_slice, true);
+    interrupts();
+    _phase = Phase::Run;
+}
+
+void StepperController::halt()
+{
+    noInterrupts();
+    pwm_set_enabled(_slice, false);
+    _running  = false;
+    _divWraps = 0;
+    interrupts();
+    _sps     = 0;
+    _braking = false;
+    _phase   = Phase::Idle;
+}
+
+/* Wrap and level are double-buffered and load at the next wrap; the
+   divider is not, so the wrap ISR writes it once the new TOP is live
+   (the next wrap, or the one after if a wrap is already pending).   */
+void StepperController::retime()
+{
+    StepTiming t = stepTiming(_clk16, _sps);
+    noInterrupts();
+    if (_running && (t.top != _cur.top || t.div16 != _cur.div16)) {
+        pwm_set_wrap(_slice, t.top);
+        pwm_set_gpio_level(_stepPin, (t.top + 1u) / 2);
+        if (t.div16 != _cur.div16) {
+            bool pending = pwm_get_irq_status_mask() & (1u << _slice);
+            _divArm   = t.div16;
+            _divWraps = pending ? 2 : 1;
+        }
+        _cur = t;
+    }
+    interrupts();
+}
+
+/* move: brake now if the distance left is what it takes to slow from
+   _sps to _spsStart, one tick of travel included                     */
+bool StepperController::mustBrake() const
+{
+    long rem = _target - _pos;
+    if (rem < 0) rem = -rem;
+    uint32_t ahead = _sps * RAMP_TICK_US / 1000000UL + 1;
+    if (uint32_t(rem) <= ahead) return true;
+    uint64_t dv2 = uint64_t(_sps) * _sps - uint64_t(_spsStart) * _spsStart;
+    return 2ull * _accelSps2 * (uint32_t(rem) - ahead) <= dv2;
+}
+
+/* ------------------------------------------------------------------ */
+/*  service() – ramp and direction state machine, every RAMP_TICK_US  */
 /* ------------------------------------------------------------------ */
 void StepperController::service()
 {
-    uint32_t now = micros();
-
-    /* ---- ramp _rpmActual toward _rpmTarget ---- */
-    static uint32_t lastAccel = now;
-    float dt = (now - lastAccel) / 1e6f;           // sec
-    lastAccel = now;
-
-    float d = _rpmTarget - _rpmActual;
-    float step = _accelRpmPerSec * dt;
-    if (fabs(d) < step) _rpmActual = _rpmTarget;
-    else _rpmActual += (d > 0 ? step : -step);
-
-    float µsPerStep = 60.0f * 1e6f / (_rpmActual * _stepsPerRev * _microstep);
-    _intCurrUs      = (uint32_t)µsPerStep;
-    if (_intCurrUs == 0) _intCurrUs = 1;
-
-    /* ---- need a step? ---- */
-    bool need = _runForever || (_pos != _target);
-    if (!need) return;
-    if (now - _lastStep < _intCurrUs) return;
-
-    /* ---- choose direction ---- */
-    bool dir = _runForever ? _dirCont : (_target > _pos);
-
-    /* ---- soft reverse if direction flips ---- */
-    static const uint16_t DIR_PAUSE_MS = 5;   // coast interval
-    if (dir != _prevDir) {
-        _drv.setDirection(dir);               // toggle DIR pin
-        _prevDir   = dir;
-
-        _rpmActual = 0.0f;                    // decel to stand-still
-        delay(DIR_PAUSE_MS);                  // small pause for rotor
-        _lastStep = micros();                 // reset timer after pause
-        return;                               // skip stepping this cycle
+    uint32_t now  = micros();
+    uint32_t dtUs = now - _lastTick;
+    if (dtUs < RAMP_TICK_US) return;
+    _lastTick = now;
+    if (dtUs > 4u * RAMP_TICK_US) dtUs = 4u * RAMP_TICK_US;   // stalled loop: no jump
+
+    long pos    = _pos;
+    long target = _target;
+    bool need   = _enabled && (_runForever || pos != target);
+    bool dir    = _runForever ? _dirCont : (target > pos);
+
+    switch (_phase) {
+    case Phase::Pause:                              // rotor settling, DIR set
+        if (now - _pauseStart < DIR_PAUSE_MS * 1000UL) return;
+        _phase = Phase::Idle;
+        [[fallthrough]];
+    case Phase::Idle:
+        if (!need) {
+            if (_rpmDirty) {
+                EEPROM.put(EEPROM_ADDR_RPM, _rpmTarget);
+                EEPROM.commit();
+                _rpmDirty = false;
+            }
+            return;
+        }
+        if (dir != _prevDir) {                      // soft reverse: pause first
+            _drv.setDirection(dir);
+            _prevDir    = dir;
+            _pauseStart = now;
+            _phase      = Phase::Pause;
+            return;
+        }
+        start();
+        return;
+    case Phase::Run:
+        break;
+    }
+
+    if (!_running) { halt(); return; }              // ISR stopped on _target
+
+    /* ---- ramp toward the set-point, or down to the start rate ---- */
+    bool stop = !need || dir != _prevDir;
+    if (!stop && !_runForever && !_braking) _braking = mustBrake();
+    uint32_t want = (stop || _braking) ? _spsStart : _spsTarget;
+
+    if (_sps != want) {
+        _rampRem += _accelSps2 * dtUs;
+        uint32_t dv = _rampRem / 1000000UL;
+        _rampRem   %= 1000000UL;
+        if (dv) {
+            if (_sps < want) _sps = (want - _sps > dv) ? _sps + dv : want;
+            else             _sps = (_sps - want > dv) ? _sps - dv : want;
+            retime();                               // only when the rate moved
+        }
+    } else {
+        _rampRem = 0;
     }
 
-    /* ---- issue STEP pulse ---- */
-    _drv.step();
-    _pos += dir ? 1 : -1;
-    _lastStep = micros();
+    if (stop && _sps == _spsStart) halt();          // next tick: pause or idle
 }
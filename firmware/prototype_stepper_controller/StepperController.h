@@ -1,19 +1,33 @@
 #pragma once
 #include <Arduino.h>
 #include <DRV8825.h>
+#include "StepTiming.h"
 
 /* ------- EEPROM layout (RP2040 “EEPROM” emulation) ------------------- */
 constexpr int EEPROM_ADDR_RPM = 0;        // stores one float (4 bytes)
 
-/* -------------------------------------------------------------------- */
+/* ------- step engine -------------------------------------------------- */
+constexpr uint32_t STEP_MAX_HZ  = 250000; // DRV8825: 1.9 µs high + 1.9 µs low
+constexpr uint16_t RAMP_TICK_US = 1000;   // ramp / direction state machine
+constexpr uint16_t DIR_PAUSE_MS = 5;      // standstill before DIR flips
+
+/* --------------------------------------------------------------------
+ * STEP comes from a PWM slice, one rising edge per wrap; the wrap
+ * ISR counts _pos and stops the slice on _target.  service() only
+ * runs the ramp: every RAMP_TICK_US it moves the rate (integer
+ * steps/s) toward the set-point, and re-times the slice when the
+ * rate changed.  A direction change brakes to the start rate, stops,
+ * writes DIR, waits DIR_PAUSE_MS and accelerates again – all without
+ * blocking loop().  One instance per sketch (the ISR is shared).
+ * -------------------------------------------------------------------- */
 class StepperController {
 public:
     StepperController(uint8_t stepPin, uint8_t dirPin, uint8_t enPin);
 
     void  begin(uint16_t stepsPerRev, uint8_t microstep);
 
-    void  enable()               { _drv.enable();  }
-    void  disable()              { _drv.disable(); }
+    void  enable()               { _drv.enable(); _enabled = true; }
+    void  disable();                               // hard stop, coils off
 
     void  setRPM(float rpmTarget);                 // ramps to new set-point
     void  runContinuous(bool on, bool cw = true);  // start / stop free-run
@@ -23,30 +37,54 @@ public:
     /* status */
     long  getPosition()  const { return _pos; }
     float getRPMTarget() const { return _rpmTarget; }
-    float getRPMActual() const { return _rpmActual; }
+    float getRPMActual() const;
     bool  isBusy()       const { return !_runForever && (_pos != _target); }
 
 private:
-    void  recomputeIntervals();
+    enum class Phase : uint8_t { Idle, Run, Pause };
+
+    static void onWrap();                          // PWM_IRQ_WRAP handler, in RAM
+
+    uint32_t rpmToSps(float rpm) const;
+    void     start();                              // Idle → Run at _spsStart
+    void     halt();                               // slice off, → Idle
+    void     retime();                             // _sps → slice
+    bool     mustBrake() const;                    // move: decel point reached
 
     DRV8825  _drv;
     uint8_t  _stepPin, _dirPin, _enPin;
     uint16_t _stepsPerRev = 200;
     uint8_t  _microstep   = 1;
+    bool     _enabled     = false;
 
     volatile long _target = 0;
     volatile long _pos    = 0;
 
-    bool _runForever = false;
+    volatile bool _runForever = false;
     bool _dirCont    = true;     // desired CW/CCW while running
     bool _prevDir    = true;     // DIR level last written to driver
 
-    /* speed & accel */
+    /* speed & accel, integer steps/s */
     float    _rpmTarget   = 60.0f;     // user set-point (saved)
-    float    _rpmActual   = 60.0f;     // ramps toward target
-    uint32_t _intTargetUs = 0;         // µs per step at target rpm
-    uint32_t _intCurrUs   = 0;         // current µs per step (accel)
+    bool     _rpmDirty    = false;     // save once stopped
+    uint32_t _spsTarget   = 0;         // set-point
+    uint32_t _spsStart    = 0;         // start / stop rate (1 rpm)
+    uint32_t _sps         = 0;         // ramp rate, 0 while stopped
+    uint32_t _accelSps2   = 0;         // steps/s per second
+    uint32_t _rampRem     = 0;         // sub-step/s carry, µs·steps/s²
     const    float _accelRpmPerSec = 300.0f;
 
-    uint32_t _lastStep = 0;
+    Phase    _phase       = Phase::Idle;
+    bool     _braking     = false;     // move decel latched
+    uint32_t _lastTick    = 0;
+    uint32_t _pauseStart  = 0;
+
+    /* PWM slice – shared with onWrap() */
+    uint32_t          _clk16 = 0;      // sys_clk · 16
+    uint32_t          _slice = 0;
+    StepTiming        _cur;            // last loaded into the slice
+    volatile bool     _running  = false;
+    volatile int8_t   _dirStep  = 1;
+    volatile uint16_t _divArm   = STEP_DIV16_MIN;
+    volatile uint8_t  _divWraps = 0;   // wrap ISRs until _divArm applies
 };
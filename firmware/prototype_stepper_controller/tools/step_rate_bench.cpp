@@ -0,0 +1,93 @@
+/*  step_rate_bench.cpp – host model of the STEP timing, before / after
+ *  -------------------------------------------------------------------
+ *    before : the loop()-driven engine – float µs period truncated to
+ *             whole µs, a pass of loop() every LOOP_US, DRV8825::step()
+ *             (2 µs pulse + two digitalWrite) taking STEP_US, and the
+ *             next period timed from micros() after step() returns
+ *    after  : the PWM slice – period from stepTiming() at 133 MHz,
+ *             i.e. the divider / TOP quantisation only
+ *  A rate is clean when every STEP period of 2000 is within ±1 % of
+ *  nominal; the max clean rate is the highest with every slower rate
+ *  clean too.  It is given for the old engine only: the PWM engine is
+ *  capped at STEP_MAX_HZ by rpmToSps(), and how close the wrap ISR
+ *  gets to it is measured on the board by tools/wrap_check, which
+ *  counts the STEP edges in hardware; pass its figure as AFTER_HZ to
+ *  print it next to the model.  LOOP_US / STEP_US are costs to
+ *  measure on the board (defaults are estimates for an idle USB
+ *  serial), pass them as arguments.
+ *
+ *      g++ -std=c++17 -O2 -o step_rate_bench step_rate_bench.cpp
+ *      ./step_rate_bench [LOOP_US] [STEP_US] [AFTER_HZ]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include "../StepTiming.h"
+
+constexpr double   STEPS_PER_REV = 200.0 * 32.0;    // config.h: 200 × 1/32
+constexpr uint32_t CLK           = 133'000'000;
+constexpr double   STEP_MAX_HZ   = 250'000.0;       // StepperController.h
+constexpr int      N             = 2000;
+
+static double loopUs = 3.0, stepUs = 2.4, afterHz = 0;   // 0: not run yet
+
+/* worst |period/nominal − 1| over N steps */
+static double before(double hz)
+{
+    double   rpm   = hz * 60.0 / STEPS_PER_REV;
+    uint32_t intUs = static_cast<uint32_t>(60.0f * 1e6f /
+                     static_cast<float>(rpm * STEPS_PER_REV));
+    if (!intUs) intUs = 1;
+
+    double   t = 0, edge = -1, worst = 0, nom = 1e6 / hz;
+    uint32_t last = 0;
+    for (int n = 0; n <= N; ) {
+        uint32_t now = static_cast<uint32_t>(t);
+        if (now - last < intUs) { t += loopUs; continue; }
+        if (edge >= 0) worst = std::fmax(worst, std::fabs((t - edge) / nom - 1.0));
+        edge = t;
+        t   += stepUs;
+        last = static_cast<uint32_t>(t);                 // _lastStep = micros()
+        t   += loopUs;
+        ++n;
+    }
+    return worst;
+}
+
+/* |period/nominal − 1| of the slice timing, every period identical */
+static double after(double hz)
+{
+    StepTiming t = stepTiming(CLK * 16u, static_cast<uint32_t>(std::lround(hz)));
+    double real  = stepTimingMilliHz(CLK * 16u, t) / 1000.0;
+    return std::fabs(hz / real - 1.0);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) loopUs = std::atof(argv[1]);
+    if (argc > 2) stepUs = std::atof(argv[2]);
+    if (argc > 3) afterHz = std::atof(argv[3]);
+    if (loopUs < 0.05) loopUs = 0.05;                  // a pass takes time
+    std::printf("loop %.2f µs, step() %.2f µs\n\n", loopUs, stepUs);
+
+    std::printf("%8s %10s %14s %14s\n", "rpm", "steps/s", "before worst %", "after worst %");
+    static const double RPMS[] = { 1, 10, 30, 60, 120, 300, 600, 1200 };
+    for (double rpm : RPMS) {
+        double hz = rpm * STEPS_PER_REV / 60.0;
+        std::printf("%8.0f %10.0f %14.2f %14.4f\n", rpm, hz, before(hz) * 100, after(hz) * 100);
+    }
+
+    double clean = 0;
+    for (double hz = 100.0; hz <= STEP_MAX_HZ && before(hz) <= 0.01; hz *= 1.01)
+        clean = hz;
+    std::printf("\nmax clean rate, before  %8.0f steps/s (%6.1f rpm)\n",
+                clean, clean * 60 / STEPS_PER_REV);
+    if (afterHz > 0)
+        std::printf("max exact rate, after   %8.0f steps/s (%6.1f rpm), wrap_check on the board\n",
+                    afterHz, afterHz * 60 / STEPS_PER_REV);
+    else
+        std::printf("after: not measured – run tools/wrap_check on the board "
+                    "(cap %.0f steps/s)\n", STEP_MAX_HZ);
+    return 0;
+}
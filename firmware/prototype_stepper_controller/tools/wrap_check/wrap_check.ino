@@ -0,0 +1,110 @@
+/*
+  wrap_check.ino
+  • Board check of the PWM step engine: does the wrap ISR count every
+    STEP edge?  A second PWM slice counts the rising edges on the STEP
+    line in hardware (B-input, rising-edge mode); the controller's own
+    count is getPosition(), one per wrap ISR.  A wrap that comes before
+    the previous ISR has cleared the flag is lost from getPosition()
+    but not from the hardware count.
+  • Runs continuously at each rate of RATES_RPM, waits for the ramp to
+    reach it, then compares both counts over WINDOW_MS.  Prints one
+    line per rate, then the highest rate with every rate up to it
+    exact – the figure README_firmware.md asks for.
+  • setRPM() stops at 1200 rpm (128 000 steps/s at 1/32), below
+    STEP_MAX_HZ; a 1/32 board cannot be driven faster from the
+    firmware.
+
+  Wiring: jumper STEP (STEP_PIN) to COUNT_PIN.  COUNT_PIN must be the
+  B pin of a slice the firmware does not use.  The motor may be
+  unplugged; the driver only has to take the STEP pulses.
+*/
+
+#include <Arduino.h>
+#include "hardware/pwm.h"
+#include "../../config.h"
+#include "../../StepperController.cpp"              // unity build
+
+/* ── test parameters ────────────────────────────────────────────────── */
+constexpr uint8_t  COUNT_PIN = D5;                  // GP7: slice 3, channel B
+constexpr uint32_t WINDOW_MS = 1000;
+constexpr uint32_t SETTLE_MS = 200;                 // after the ramp ends
+constexpr float    RATES_RPM[] = { 60, 120, 240, 480, 600, 720, 840, 960, 1080, 1200 };
+
+StepperController motor(STEP_PIN, DIR_PIN, EN_PIN);
+
+static uint32_t gCntSlice;
+static uint16_t gCntLast;
+static uint64_t gEdges;                             // 16-bit counter, extended
+
+/* run the motor's service() and extend the edge counter; the counter
+   wraps after 65536 edges, ≥ 0.5 s at 128 000 steps/s             */
+static void spin(uint32_t ms)
+{
+  uint32_t t0 = millis();
+  while (millis() - t0 < ms) {
+    motor.service();
+    uint16_t c = pwm_get_counter(gCntSlice);
+    gEdges  += uint16_t(c - gCntLast);
+    gCntLast = c;
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  while (!Serial) {}
+
+  gCntSlice = pwm_gpio_to_slice_num(COUNT_PIN);
+  if (pwm_gpio_to_channel(COUNT_PIN) != PWM_CHAN_B ||
+      gCntSlice == pwm_gpio_to_slice_num(STEP_PIN)) {
+    Serial.println(F("COUNT_PIN must be a B pin on another slice"));
+    return;
+  }
+  pwm_config cfg = pwm_get_default_config();
+  pwm_config_set_clkdiv_mode(&cfg, PWM_DIV_B_RISING);
+  pwm_config_set_clkdiv(&cfg, 1.0f);
+  pwm_init(gCntSlice, &cfg, false);
+  gpio_set_function(COUNT_PIN, GPIO_FUNC_PWM);
+  pwm_set_enabled(gCntSlice, true);
+
+  motor.begin(STEPS_PER_REV, MICROSTEP);
+  float saved = motor.getRPMTarget();               // put back afterwards
+  motor.enable();
+  motor.runContinuous(true, true);
+
+  Serial.println(F("rpm  steps/s  wraps  edges  lost"));
+  float clean = 0;
+  bool  exact = true;
+  for (float rpm : RATES_RPM) {
+    motor.setRPM(rpm);
+    while (motor.getRPMActual() < 0.995f * motor.getRPMTarget()) spin(10);
+    spin(SETTLE_MS);
+
+    long     p0 = motor.getPosition();
+    uint64_t e0 = gEdges;
+    spin(WINDOW_MS);
+    long     wraps = motor.getPosition() - p0;
+    long     edges = long(gEdges - e0);
+    long     lost  = edges - wraps;
+
+    /* the two reads are a few instructions apart: ±1 is phase */
+    bool ok = lost <= 1 && lost >= -1;
+    if (ok && exact) clean = rpm;
+    else             exact = false;
+    Serial.printf("%4.0f %8.0f %6ld %6ld %5ld %s\n", rpm,
+                  rpm * STEPS_PER_REV * MICROSTEP / 60.0f, wraps, edges, lost,
+                  ok ? "ok" : "LOST");
+  }
+  motor.runContinuous(false);
+  motor.setRPM(saved);
+
+  Serial.printf("max rate, wrap count = STEP edges: %.0f steps/s (%.0f rpm)%s\n",
+                clean * STEPS_PER_REV * MICROSTEP / 60.0f, clean,
+                clean == RATES_RPM[sizeof(RATES_RPM) / sizeof(RATES_RPM[0]) - 1]
+                    ? " – the setRPM() ceiling, not the engine's" : "");
+}
+
+void loop()
+{
+  motor.service();
+}
@@ -0,0 +1,201 @@
+/*  column_store.cpp – buffered column appends & mmap reader
+ */
+
+#include "column_store.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace srl {
+
+static constexpr uint16_t COL_VERSION = 1;
+static constexpr uint16_t TYPE_I64    = 0;
+static constexpr uint16_t TYPE_F64    = 1;
+static constexpr size_t   IO_BUF      = 1 << 16;
+
+/* open for append; write a header if the file is new */
+static FILE* openCol(const std::string& path, uint16_t type)
+{
+    FILE* f = fopen(path.c_str(), "ab");
+    if (!f) return nullptr;
+    setvbuf(f, nullptr, _IOFBF, IO_BUF);
+
+    if (ftell(f) == 0) {
+        ColHeader h{{'S', 'R', 'L', 'C'}, COL_VERSION, type, 0};
+        fwrite(&h, sizeof h, 1, f);
+    }
+    return f;
+}
+
+static uint64_t colRows(const std::string& path)
+{
+    struct stat st{};
+    if (stat(path.c_str(), &st) != 0 || st.st_size < (off_t)sizeof(ColHeader))
+        return 0;
+    return (st.st_size - sizeof(ColHeader)) / 8;
+}
+
+/* ═════════════════════════════ writer ═════════════════════════════ */
+ColumnWriter::ColumnWriter(std::string dir) : _dir(std::move(dir)) {}
+
+ColumnWriter::~ColumnWriter()
+{
+    flush();
+    for (auto& c : _cols) fclose(c.f);
+    if (_ts)    fclose(_ts);
+    if (_index) fclose(_index);
+}
+
+bool ColumnWriter::open()
+{
+    mkdir(_dir.c_str(), 0755);
+
+    /* resume an existing log: collect columns, cut every file back
+       to the shortest one so a torn tail cannot misalign rows       */
+    std::vector<std::pair<std::string, std::string>> known;   // key, file
+    if (FILE* idx = fopen((_dir + "/fields.tsv").c_str(), "r")) {
+        char line[512];
+        while (fgets(line, sizeof line, idx)) {
+            char* tab = strchr(line, '\t');
+            if (!tab) continue;
+            *tab = '\0';
+            tab[strcspn(tab + 1, "\r\n") + 1] = '\0';
+            known.emplace_back(line, tab + 1);
+        }
+        fclose(idx);
+    }
+
+    const std::string tsPath = _dir + "/_ts.col";
+    _rows = colRows(tsPath);
+    for (auto& k : known) _rows = std::min(_rows, colRows(_dir + "/" + k.second));
+
+    const off_t len = sizeof(ColHeader) + 8 * _rows;
+    if (_rows) {
+        truncate(tsPath.c_str(), len);
+        for (auto& k : known) truncate((_dir + "/" + k.second).c_str(), len);
+    }
+
+    if (!(_ts = openCol(tsPath, TYPE_I64))) return false;
+    for (auto& k : known) {
+        FILE* f = openCol(_dir + "/" + k.second, TYPE_F64);
+        if (!f) return false;
+        _byKey[k.first] = _cols.size();
+        _cols.push_back({k.first, f});
+    }
+
+    _index = fopen((_dir + "/fields.tsv").c_str(), "a");
+    return _index != nullptr;
+}
+
+ColumnWriter::Col* ColumnWriter::column(const std::string& key)
+{
+    auto it = _byKey.find(key);
+    if (it != _byKey.end()) return &_cols[it->second];
+
+    /* new field mid-run: create and back-fill NaN for earlier rows */
+    std::string file = std::to_string(_cols.size()) + ".col";
+    FILE* f = openCol(_dir + "/" + file, TYPE_F64);
+    if (!f) return nullptr;
+
+    const double nan = NAN;
+    for (uint64_t i = 0; i < _rows; ++i) fwrite(&nan, 8, 1, f);
+
+    fprintf(_index, "%s\t%s\n", key.c_str(), file.c_str());
+    fflush(_index);
+
+    _byKey[key] = _cols.size();
+    _cols.push_back({key, f});
+    return &_cols.back();
+}
+
+void ColumnWriter::append(int64_t ts_us, const Record& rec)
+{
+    /* resolve columns first so the row scratch covers new ones */
+    for (const Field& fd : rec) column(fd.key);
+
+    _row.assign(_cols.size(), NAN);
+    for (const Field& fd : rec) _row[_byKey[fd.key]] = fd.value;
+
+    fwrite(&ts_us, 8, 1, _ts);
+    for (size_t i = 0; i < _cols.size(); ++i) fwrite(&_row[i], 8, 1, _cols[i].f);
+    ++_rows;
+}
+
+void ColumnWriter::flush()
+{
+    if (_ts) fflush(_ts);
+    for (auto& c : _cols) fflush(c.f);
+}
+
+/* ═════════════════════════════ reader ═════════════════════════════ */
+ColumnReader::~ColumnReader()
+{
+    for (auto& m : _maps) munmap(m.base, m.len);
+}
+
+const void* ColumnReader::mapFile(const std::string& path, uint16_t type,
+                                  uint64_t& n)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st{};
+    fstat(fd, &st);
+    if (st.st_size < (off_t)sizeof(ColHeader)) { close(fd); return nullptr; }
+
+    void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return nullptr;
+    _maps.push_back({base, (size_t)st.st_size});
+
+    const ColHeader* h = static_cast<const ColHeader*>(base);
+    if (memcmp(h->magic, "SRLC", 4) || h->version != COL_VERSION || h->type != type)
+        return nullptr;
+
+    madvise(base, st.st_size, MADV_SEQUENTIAL);
+    n = (st.st_size - sizeof(ColHeader)) / 8;
+    return static_cast<const char*>(base) + sizeof(ColHeader);
+}
+
+bool ColumnReader::open(const std::string& dir)
+{
+    uint64_t n = 0;
+    _ts = static_cast<const int64_t*>(mapFile(dir + "/_ts.col", TYPE_I64, n));
+    if (!_ts) return false;
+    _rows = n;
+
+    FILE* idx = fopen((dir + "/fields.tsv").c_str(), "r");
+    if (!idx) return false;
+    char line[512];
+    while (fgets(line, sizeof line, idx)) {
+        char* tab = strchr(line, '\t');
+        if (!tab) continue;
+        *tab = '\0';
+        tab[strcspn(tab + 1, "\r\n") + 1] = '\0';
+        auto* d = static_cast<const double*>(
+                      mapFile(dir + "/" + (tab + 1), TYPE_F64, n));
+        if (!d) { fclose(idx); return false; }
+        _rows = std::min(_rows, n);                 // torn tail after a crash
+        _keys.emplace_back(line);
+        _data.push_back(d);
+    }
+    fclose(idx);
+    return true;
+}
+
+int ColumnReader::find(const std::string& key) const
+{
+    auto it = std::find(_keys.begin(), _keys.end(), key);
+    return it == _keys.end() ? -1 : static_cast<int>(it - _keys.begin());
+}
+
+uint64_t ColumnReader::seek(int64_t t_us) const
+{
+    return std::lower_bound(_ts, _ts + _rows, t_us) - _ts;
+}
+
+}   // namespace srl
@@ -0,0 +1,86 @@
+#pragma once
+/*  column_store.hpp ─ append-only columnar log, one file per field
+ *  ----------------------------------------------------------------
+ *  Directory layout
+ *      _ts.col      int64   host receive time, µs since Unix epoch
+ *      <n>.col      double  one per telemetry key (NaN where absent)
+ *      fields.tsv   "<key>\t<n>.col" per line, in creation order
+ *
+ *  Every .col file is a 16-byte header followed by packed 8-byte
+ *  little-endian values, so row i lives at 16 + 8·i and the files
+ *  can be mmap()ed directly.  _ts.col is non-decreasing, which makes
+ *  time seeks a binary search.
+ */
+
+#include "json_stream.hpp"
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace srl {
+
+struct ColHeader {
+    char     magic[4];          // "SRLC"
+    uint16_t version;           // 1
+    uint16_t type;              // 0 = int64, 1 = double
+    uint64_t reserved;
+};
+static_assert(sizeof(ColHeader) == 16, "column header must stay 16 bytes");
+
+/* ───── writer ───── */
+class ColumnWriter {
+public:
+    explicit ColumnWriter(std::string dir);
+    ~ColumnWriter();
+
+    bool open();                                    // creates dir, appends if present
+    void append(int64_t ts_us, const Record& rec);
+    void flush();
+
+    uint64_t rows()    const { return _rows; }
+    size_t   columns() const { return _cols.size(); }
+
+private:
+    struct Col { std::string key; FILE* f; };
+
+    Col* column(const std::string& key);
+
+    std::string                _dir;
+    FILE*                      _ts{nullptr};
+    FILE*                      _index{nullptr};
+    std::vector<Col>           _cols;
+    std::map<std::string, size_t> _byKey;
+    std::vector<double>        _row;                // scratch, one per column
+    uint64_t                   _rows{0};
+};
+
+/* ───── reader (mmap) ───── */
+class ColumnReader {
+public:
+    ~ColumnReader();
+
+    bool open(const std::string& dir);
+
+    uint64_t rows() const { return _rows; }
+    const std::vector<std::string>& keys() const { return _keys; }
+
+    int64_t ts(uint64_t row) const { return _ts[row]; }
+    double  value(size_t col, uint64_t row) const { return _data[col][row]; }
+    int     find(const std::string& key) const;     // -1 if absent
+
+    /* first row with ts ≥ t_us */
+    uint64_t seek(int64_t t_us) const;
+
+private:
+    struct Map { void* base; size_t len; };
+    const void* mapFile(const std::string& path, uint16_t type, uint64_t& n);
+
+    std::vector<Map>           _maps;
+    const int64_t*             _ts{nullptr};
+    std::vector<const double*> _data;
+    std::vector<std::string>   _keys;
+    uint64_t                   _rows{0};
+};
+
+}   // namespace srl
@@ -0,0 +1,103 @@
+/*  json_stream.cpp – line framing + flat-object decoder
+ */
+
+#include "json_stream.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace srl {
+
+static inline const char* skipWs(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p;
+}
+
+/* ───── framing: split on '\n', tolerate chunk boundaries ───── */
+void JsonStream::feed(const char* data, size_t n)
+{
+    const char* p   = data;
+    const char* end = data + n;
+
+    while (p < end) {
+        const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+        const char* stop = nl ? nl : end;
+
+        if (!_overflow) {
+            if (_line.size() + (stop - p) > MAX_LINE) _overflow = true;
+            else _line.append(p, stop);
+        }
+        if (!nl) break;                              // wait for the rest
+
+        if (_overflow || !parseLine(_line.data(), _line.data() + _line.size()))
+            ++_skipped;
+        _line.clear();
+        _overflow = false;
+        p = nl + 1;
+    }
+}
+
+/* ───── {"key":number, …} ───── */
+bool JsonStream::parseLine(const char* p, const char* end)
+{
+    _rec.clear();
+
+    p = skipWs(p, end);
+    if (p >= end || *p++ != '{') return false;
+
+    for (;;) {
+        p = skipWs(p, end);
+        if (p < end && *p == '}') break;             // empty / trailing
+
+        /* key */
+        if (p >= end || *p++ != '"') return false;
+        const char* k0 = p;
+        while (p < end && *p != '"') ++p;
+        if (p >= end) return false;
+        std::string key(k0, p++);
+
+        p = skipWs(p, end);
+        if (p >= end || *p++ != ':') return false;
+        p = skipWs(p, end);
+        if (p >= end) return false;
+
+        /* value */
+        if (*p == '"') {                             // string → drop
+            ++p;
+            while (p < end && *p != '"') p += (*p == '\\') ? 2 : 1;
+            if (p >= end) return false;
+            ++p;
+        } else if (*p == '{' || *p == '[') {
+            return false;                            // nested: not ours
+        } else if (end - p >= 4 && !strncmp(p, "true", 4)) {
+            _rec.push_back({std::move(key), 1.0});  p += 4;
+        } else if (end - p >= 5 && !strncmp(p, "false", 5)) {
+            _rec.push_back({std::move(key), 0.0});  p += 5;
+        } else if (end - p >= 4 && !strncmp(p, "null", 4)) {
+            p += 4;
+        } else {
+            char  tmp[64];
+            size_t len = 0;
+            while (p < end && len < sizeof(tmp) - 1 &&
+                   *p != ',' && *p != '}' && *p != ' ')
+                tmp[len++] = *p++;
+            tmp[len] = '\0';
+            char* e;
+            double v = strtod(tmp, &e);
+            if (e == tmp || *e) return false;
+            _rec.push_back({std::move(key), v});
+        }
+
+        p = skipWs(p, end);
+        if (p < end && *p == ',') { ++p; continue; }
+        if (p < end && *p == '}') break;
+        return false;
+    }
+
+    if (_rec.empty()) return false;
+    ++_records;
+    _sink(_rec);
+    return true;
+}
+
+}   // namespace srl
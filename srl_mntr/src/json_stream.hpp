@@ -0,0 +1,48 @@
+#pragma once
+/*  json_stream.hpp ─ incremental decoder for the controller's serial feed
+ *  ----------------------------------------------------------------------
+ *  feed() accepts arbitrary chunks (split anywhere) and emits one Record
+ *  per complete line that is a flat JSON object of numeric fields, e.g.
+ *      {"t":1234,"sp":500,"r_flw":498,...}
+ *  Non-JSON lines ("[BTN] …", "OK", …) are counted and skipped.
+ *  Boolean values decode to 0 / 1; string and null values are dropped.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace srl {
+
+struct Field {
+    std::string key;
+    double      value;
+};
+using Record = std::vector<Field>;
+
+class JsonStream {
+public:
+    using Sink = std::function<void(const Record&)>;
+
+    explicit JsonStream(Sink sink) : _sink(std::move(sink)) {}
+
+    void feed(const char* data, size_t n);
+
+    uint64_t records()  const { return _records; }
+    uint64_t skipped()  const { return _skipped; }
+
+private:
+    static constexpr size_t MAX_LINE = 4096;
+
+    bool parseLine(const char* p, const char* end);
+
+    Sink        _sink;
+    std::string _line;
+    bool        _overflow{false};
+    Record      _rec;               // reused between lines
+    uint64_t    _records{0}, _skipped{0};
+};
+
+}   // namespace srl
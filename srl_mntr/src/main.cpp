@@ -0,0 +1,208 @@
+/*  srl_rec – serial telemetry recorder / exporter for the flow controller
+ *  ---------------------------------------------------------------------
+ *  srl_rec record <device|file|-> <dir> [baud]
+ *      Decode the controller's JSON stream into a column store.
+ *      A tty (USB CDC port or pseudo-terminal) is put into raw mode;
+ *      a regular file or stdin is replayed until EOF.
+ *  srl_rec export <dir> [from_s] [to_s] [key,key,…]
+ *      Write rows in [from_s, to_s) (seconds from the first row) as CSV.
+ *  srl_rec info <dir>
+ *      Row count, time span and field list.
+ */
+
+#include "column_store.hpp"
+#include "json_stream.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace srl;
+
+static volatile sig_atomic_t gStop = 0;
+static void onSignal(int) { gStop = 1; }
+
+static int64_t nowUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+static speed_t baudFlag(long baud)
+{
+    switch (baud) {
+        case 9600:   return B9600;
+        case 57600:  return B57600;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default:     return B115200;
+    }
+}
+
+/* ───── record ───── */
+static int cmdRecord(const char* src, const char* dir, long baud)
+{
+    int fd = strcmp(src, "-") ? open(src, O_RDONLY | O_NOCTTY) : STDIN_FILENO;
+    if (fd < 0) { perror(src); return 1; }
+
+    const bool tty = isatty(fd);
+    if (tty) {
+        termios tio{};
+        tcgetattr(fd, &tio);
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, baudFlag(baud));
+        cfsetospeed(&tio, baudFlag(baud));
+        tio.c_cc[VMIN]  = 1;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    ColumnWriter store(dir);
+    if (!store.open()) { fprintf(stderr, "cannot open store %s\n", dir); return 1; }
+
+    /* replayed files have no arrival times: stamp rows from the
+       device's own "t" (ms) on top of the replay start instead.  A
+       device reset restarts "t"; the new run is laid after the last
+       stamp of the old one, so time keeps advancing               */
+    const int64_t t0 = nowUs();
+    int64_t rxUs = t0, lastTs = t0, base = t0;
+    double  lastT = 0;
+    JsonStream parser([&](const Record& r) {
+        int64_t ts = tty ? rxUs : lastTs;
+        if (!tty) {
+            for (const Field& f : r) {
+                if (f.key != "t") continue;
+                if (f.value < lastT) base += static_cast<int64_t>(lastT * 1000.0);
+                lastT = f.value;
+                ts = base + static_cast<int64_t>(f.value * 1000.0);
+                break;
+            }
+        }
+        if (ts < lastTs) ts = lastTs;                   // keep the index sorted
+        store.append(lastTs = ts, r);
+    });
+
+    signal(SIGINT,  onSignal);
+    signal(SIGTERM, onSignal);
+
+    static char buf[1 << 16];
+    int64_t lastFlush = t0, lastNote = t0;
+    while (!gStop) {
+        ssize_t n = read(fd, buf, sizeof buf);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EIO) perror("read");         // EIO: port / pty went away
+            break;
+        }
+        if (n == 0) break;                              // EOF (file / closed pty)
+
+        rxUs = nowUs();
+        parser.feed(buf, static_cast<size_t>(n));
+
+        if (rxUs - lastFlush > 1'000'000) { store.flush(); lastFlush = rxUs; }
+        if (tty && rxUs - lastNote > 10'000'000) {
+            fprintf(stderr, "\r%llu rows, %zu fields, %llu skipped   ",
+                    (unsigned long long)store.rows(), store.columns(),
+                    (unsigned long long)parser.skipped());
+            lastNote = rxUs;
+        }
+    }
+
+    store.flush();
+    fprintf(stderr, "\n%llu rows, %zu fields, %llu lines skipped\n",
+            (unsigned long long)store.rows(), store.columns(),
+            (unsigned long long)parser.skipped());
+    if (fd != STDIN_FILENO) close(fd);
+    return 0;
+}
+
+/* ───── export ───── */
+static int cmdExport(const char* dir, double from_s, double to_s, const char* keys)
+{
+    ColumnReader rd;
+    if (!rd.open(dir)) { fprintf(stderr, "cannot read store %s\n", dir); return 1; }
+    if (!rd.rows()) return 0;
+
+    std::vector<int> cols;
+    if (keys && *keys) {
+        std::stringstream ss(keys);
+        std::string k;
+        while (std::getline(ss, k, ',')) {
+            int c = rd.find(k);
+            if (c < 0) { fprintf(stderr, "unknown field %s\n", k.c_str()); return 1; }
+            cols.push_back(c);
+        }
+    } else {
+        for (size_t c = 0; c < rd.keys().size(); ++c) cols.push_back(static_cast<int>(c));
+    }
+
+    const int64_t base = rd.ts(0);
+    uint64_t r0 = rd.seek(base + static_cast<int64_t>(from_s * 1e6));
+    uint64_t r1 = std::isinf(to_s) ? rd.rows()
+                                   : rd.seek(base + static_cast<int64_t>(to_s * 1e6));
+
+    static char obuf[1 << 20];
+    setvbuf(stdout, obuf, _IOFBF, sizeof obuf);
+
+    fputs("time_s", stdout);
+    for (int c : cols) { putchar(','); fputs(rd.keys()[c].c_str(), stdout); }
+    putchar('\n');
+
+    for (uint64_t r = r0; r < r1; ++r) {
+        printf("%.6f", (rd.ts(r) - base) * 1e-6);
+        for (int c : cols) {
+            double v = rd.value(c, r);
+            if (std::isnan(v)) putchar(',');
+            else               printf(",%.10g", v);
+        }
+        putchar('\n');
+    }
+    return 0;
+}
+
+/* ───── info ───── */
+static int cmdInfo(const char* dir)
+{
+    ColumnReader rd;
+    if (!rd.open(dir)) { fprintf(stderr, "cannot read store %s\n", dir); return 1; }
+
+    double span = rd.rows() ? (rd.ts(rd.rows() - 1) - rd.ts(0)) * 1e-6 : 0.0;
+    printf("rows   %llu\nspan   %.3f s\nfields", (unsigned long long)rd.rows(), span);
+    for (const auto& k : rd.keys()) printf(" %s", k.c_str());
+    putchar('\n');
+    return 0;
+}
+
+static void usage()
+{
+    fputs("usage: srl_rec record <device|file|-> <dir> [baud]\n"
+          "       srl_rec export <dir> [from_s] [to_s] [key,key,...]\n"
+          "       srl_rec info   <dir>\n", stderr);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 4 && !strcmp(argv[1], "record"))
+        return cmdRecord(argv[2], argv[3], argc > 4 ? atol(argv[4]) : 115200);
+
+    if (argc >= 3 && !strcmp(argv[1], "export"))
+        return cmdExport(argv[2],
+                         argc > 3 ? atof(argv[3]) : 0.0,
+                         argc > 4 ? atof(argv[4]) : INFINITY,
+                         argc > 5 ? argv[5] : nullptr);
+
+    if (argc >= 3 && !strcmp(argv[1], "info"))
+        return cmdInfo(argv[2]);
+
+    usage();
+    return 2;
+}
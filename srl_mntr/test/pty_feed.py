@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+# pty_feed.py – play a capture into srl_rec through a pseudo-terminal
+#
+#     pty_feed.py <srl_rec> <capture> <dir>
+#
+# Opens a pty, starts "srl_rec record <slave> <dir>", writes the capture
+# in 7-byte chunks so lines arrive split, waits until the recorder has
+# read everything, then hangs up the master (srl_rec sees EIO and ends).
+import fcntl, os, pty, struct, subprocess, sys, termios, time, tty
+
+rec, capture, store = sys.argv[1:4]
+master, slave = pty.openpty()
+tty.setraw(slave)                                   # no echo / CR mapping before srl_rec
+proc = subprocess.Popen([rec, "record", os.ttyname(slave), store])
+
+data = open(capture, "rb").read()
+for i in range(0, len(data), 7):
+    os.write(master, data[i:i + 7])
+
+def pending():
+    buf = fcntl.ioctl(slave, termios.FIONREAD, struct.pack("i", 0))
+    return struct.unpack("i", buf)[0]
+
+deadline = time.time() + 10
+while pending() and time.time() < deadline:
+    time.sleep(0.01)
+os.close(slave)
+os.close(master)
+sys.exit(proc.wait(timeout=10))
@@ -0,0 +1,61 @@
+#!/bin/sh
+# run.sh – end-to-end test of srl_rec: record → info → export
+#
+#     ./run.sh
+#
+# capture.log is a controller stream as it comes off the USB port
+# (CRLF, boot and button lines, a string field, a nested line, a cut-off
+# line, a reset of "t").  It is recorded from a file, from stdin and
+# through a pseudo-terminal, and the exports are compared with the
+# expect_*.csv files.  The pty case stamps rows with arrival time, so
+# only its values are compared; it is skipped without python3.
+# Exits non-zero when a case fails.
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+B=build
+rm -rf $B && mkdir -p $B
+$CXX -std=c++17 -O2 -Wall -o $B/srl_rec ../src/*.cpp || exit 1
+REC=$B/srl_rec
+fail=0
+
+check() {       # <what> <expected> <actual>
+    if cmp -s "$2" "$3"; then printf '%-14s pass\n' "$1"
+    else printf '%-14s FAIL\n' "$1"; diff "$2" "$3" | head -20; fail=1; fi
+}
+
+echo "── file"
+$REC record capture.log $B/file 2>$B/file.log
+grep -q '10 rows, 7 fields, 6 lines skipped' $B/file.log ||
+    { echo "counts         FAIL: $(tail -1 $B/file.log)"; fail=1; }
+$REC export $B/file > $B/all.csv
+check "export all" expect_all.csv $B/all.csv
+$REC export $B/file 0.02 0.05 r_flw,temp > $B/slice.csv
+check "export slice" expect_slice.csv $B/slice.csv
+$REC info $B/file > $B/info.txt
+printf 'rows   10\nspan   0.100 s\nfields t sp r_flw f_flw on temp occ_r\n' > $B/info.want
+check "info" $B/info.want $B/info.txt
+$REC export $B/file 0 1 nope > /dev/null 2>&1 &&
+    { echo "unknown key    FAIL: accepted"; fail=1; }
+
+echo "── stdin"
+$REC record - $B/stdin < capture.log 2>/dev/null
+$REC export $B/stdin > $B/stdin.csv
+check "export all" expect_all.csv $B/stdin.csv
+
+echo "── append"
+$REC record capture.log $B/file 2>/dev/null
+$REC info $B/file | grep -q '^rows   20$' && echo "append rows    pass" ||
+    { echo "append rows    FAIL: $($REC info $B/file | head -1)"; fail=1; }
+
+echo "── pty"
+if command -v python3 > /dev/null; then
+    python3 pty_feed.py $REC capture.log $B/pty 2>$B/pty.log
+    $REC export $B/pty | cut -d, -f2- > $B/pty.csv
+    cut -d, -f2- expect_all.csv > $B/pty.want
+    check "values" $B/pty.want $B/pty.csv
+    grep -q '10 rows, 7 fields, 6 lines skipped' $B/pty.log ||
+        { echo "counts         FAIL: $(tail -1 $B/pty.log)"; fail=1; }
+else
+    echo "skipped (no python3)"
+fi
+exit $fail